@@ -36,10 +36,21 @@ public class AnimationActorSystem : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
-				"Slate",
-				"SlateCore",
+				"AssetRegistry",
 			}
 			);
+
+		// Only used for editor notifications, and not needed by servers or cooked games.
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.AddRange(
+				new string[]
+				{
+					"Slate",
+					"SlateCore",
+				}
+				);
+		}
 		
 		
 		DynamicallyLoadedModuleNames.AddRange(
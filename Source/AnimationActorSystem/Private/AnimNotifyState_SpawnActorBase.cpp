@@ -5,12 +5,16 @@
 
 #include "AnimationActorSubsystem.h"
 #include "AnimationActorSystem.h"
+#include "AnimationActorSystemSettings.h"
+#include "AnimationActorSystemStats.h"
 #include "Animation/AnimNotifyLibrary.h"
 #include "Animation/MirrorDataTable.h"
 #include "Animation/AnimSequenceBase.h"
 #include "Engine/AssetManager.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/StreamableManager.h"
+#include "UObject/UObjectArray.h"
+#include "Algo/AllOf.h"
 
 void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
                                                   float TotalDuration,
@@ -18,7 +22,7 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 {
 	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
 	
-	if (!(MeshComp && Animation))
+	if (!(MeshComp && Animation) || IsSkippedOnServer(MeshComp))
 	{
 		return;
 	}
@@ -37,12 +41,17 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 		return;
 	}
 	AActor* Owner = MeshComp->GetOwner();
-	if (Owner && Owner->ActorHasTag(UAnimationActorSubsystem::SpawnedAnimActorTag))
+	if ((Owner && Owner->ActorHasTag(UAnimationActorSubsystem::SpawnedAnimActorTag))
+		|| MeshComp->ComponentHasTag(UAnimationActorSubsystem::SpawnedAnimActorTag))
 	{
 		return;
 	}
 
 	const FGuid SpawnGuid = ConstructDeterministicGuidFromComponent(MeshComp);
+	if (UAnimationActorSubsystem* SubSys = UAnimationActorSubsystem::Get(MeshComp))
+	{
+		SubSys->RecordNotifyEvent(AnimActorSys::ENotifyCaptureEvent::Begin, this, MeshComp, EventReference, TotalDuration);
+	}
 	
 #pragma region EditorOnlyPreview
 #if WITH_EDITOR
@@ -58,7 +67,7 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 			const bool bPlayheadIsWithinNotifyWindow = ActiveMontagePosition <= Notify->GetEndTriggerTime() &&
 					ActiveMontagePosition >= Notify->GetTriggerTime();
 			if (bPlayheadIsWithinNotifyWindow
-				&& SubSys->GetAnimActorByGuid(SpawnGuid))
+				&& SubSys->IsAnimActorRegistered(SpawnGuid))
 			{
 				/** For some reason Unreal Handles NotifyStates differently when scrubbing through an AnimSequence vs an AnimMontage.
 				 * For an AnimSequence, the NotifyState starts when entering the NotifyWindow, and ends when exiting the window, ticking inbetween.
@@ -78,7 +87,29 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 	}
 #endif
 #pragma endregion
+
+	// Don't even load anything if the system is scaled down completely, or for owners nobody will notice.
+	if (UAnimationActorSubsystem* SubSys = UAnimationActorSubsystem::Get(MeshComp))
+	{
+		if (!UAnimationActorSystemSettings::Get()->IsSystemEnabled()
+			|| (bAllowSignificanceCulling && SubSys->EvaluateSignificance(MeshComp) == EAnimActorSignificance::Skip))
+		{
+			SubSys->SkipAnimActor(SpawnGuid);
+			return;
+		}
+	}
+	
+	// The class and all assets the notify needs go through the same loading behaviour, so they're ready at the same time.
+	TArray<FSoftObjectPath> AssetsToLoad;
+	GatherSpawnDependencies(AssetsToLoad);
 	
+	// NotifyEnd may arrive before the loading is done, which has to cancel the spawn.
+	UAnimationActorSubsystem* SubSys = UAnimationActorSubsystem::Get(MeshComp);
+	if (SubSys)
+	{
+		SubSys->BeginPendingLoad(SpawnGuid);
+	}
+	TWeakObjectPtr<UAnimationActorSubsystem> WeakSubSys(SubSys);
 	TWeakObjectPtr<USkeletalMeshComponent> WeakMeshComp(MeshComp);
 	TWeakObjectPtr<UAnimSequenceBase> WeakAnimation(Animation);
 	AnimActorSys::FWeakAnimNotifyEventReference WeakEventRef(EventReference);
@@ -88,30 +119,90 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 #endif
 
 	auto ClassLoaded = [this,
+		LoadStartCycle = FPlatformTime::Cycles64(),
 		SpawnableClass,
 		NotifyAttachTransform = AttachTransform,
+		NotifySpawnPriority = SpawnPriority,
 		SpawnGuid,
+		WeakSubSys,
 		WeakMeshComp,
 		WeakAnimation,
 		TotalDuration,
-		WeakEventRef]
+		WeakEventRef,
+		AssetsToLoad]
 		{
+			UAnimationActorSubsystem* SubSys_Local = WeakSubSys.Get();
+			if (SubSys_Local && !SubSys_Local->FinishPendingLoad(SpawnGuid))
+			{
+				// The notify has ended already, so nothing would ever end what gets spawned now.
+				SubSys_Local->KeepAssetsLoaded(AssetsToLoad);
+				return;
+			}
+
 			USkeletalMeshComponent* MeshComp_Local = WeakMeshComp.Get();
 			UAnimSequenceBase* Animation_Local = WeakAnimation.Get();
-			UAnimationActorSubsystem* SubSys_Local = UAnimationActorSubsystem::Get(MeshComp_Local);
 			if (!SpawnableClass || !MeshComp_Local || !Animation_Local || !SubSys_Local)
 			{
 				UE_LOG(LogAnimActorSys, Error, TEXT("Failed to spawn AnimActor (%s)."), SpawnableClass ? *SpawnableClass->GetName() : TEXT("InvalidClass"));
 				return;
 			}
-		
-			AActor* SpawnedActor = SubSys_Local->SpawnAnimActor(SpawnableClass.Get(),
-																NotifyAttachTransform,
-																SpawnGuid);
-			if(SpawnedActor /**May still be nullptr, for example if the world is tearing down*/)
+			AnimActorSys::RecordClassLoadWait(SpawnGuid, LoadStartCycle);
+			SubSys_Local->KeepAssetsLoaded(AssetsToLoad);
+
+			if (!SubSys_Local->AdmitAnimActor(SpawnGuid, SpawnableClass.Get(), GetConcurrencyAsset(), NotifySpawnPriority, MeshComp_Local))
 			{
-				PostSpawnActor(SpawnedActor, SubSys_Local, MeshComp_Local, Animation_Local, TotalDuration, WeakEventRef.ToEventReference());
+				SubSys_Local->SkipAnimActor(SpawnGuid);
+				return;
 			}
+
+			if (SpawnWithoutActor(SubSys_Local, MeshComp_Local, SpawnGuid, WeakEventRef.ToEventReference()))
+			{
+				if (bAllowSignificanceCulling)
+				{
+					SubSys_Local->TrackSignificance(SpawnGuid, MeshComp_Local);
+				}
+				return;
+			}
+
+			// The spawn may be deferred to a later frame by the subsystem's frame budget,
+			// so everything has to be re-validated once it actually happens.
+			SubSys_Local->RequestAnimActor(SpawnableClass.Get(),
+			                               NotifyAttachTransform,
+			                               SpawnGuid,
+			                               NotifySpawnPriority,
+			                               [WeakThis = TWeakObjectPtr<UAnimNotifyState_SpawnActorBase>(this),
+				                               SpawnGuid, WeakMeshComp, WeakAnimation, TotalDuration, WeakEventRef]
+			                               (AActor* SpawnedActor)
+			                               {
+				                               USkeletalMeshComponent* MeshComp_Spawned = WeakMeshComp.Get();
+				                               UAnimationActorSubsystem* SubSys_Spawned = UAnimationActorSubsystem::Get(SpawnedActor);
+				                               if (!WeakThis.IsValid() || !MeshComp_Spawned || !WeakAnimation.IsValid())
+				                               {
+					                               // Nobody is left to end this notify, so don't leave the actor behind.
+					                               if (SubSys_Spawned)
+					                               {
+						                               SubSys_Spawned->DestroyAnimActor(SpawnGuid);
+					                               }
+					                               return;
+				                               }
+				                               ANIMACTORSYS_SCOPE(PostSpawnActor, SpawnGuid);
+				                               WeakThis->PostSpawnActor(SpawnedActor, SubSys_Spawned, MeshComp_Spawned,
+				                                                        WeakAnimation.Get(), TotalDuration,
+				                                                        WeakEventRef.ToEventReference());
+				                               if (WeakThis->bAllowSignificanceCulling)
+				                               {
+					                               SubSys_Spawned->TrackSignificance(SpawnGuid, MeshComp_Spawned);
+				                               }
+			                               },
+			                               [WeakThis = TWeakObjectPtr<UAnimNotifyState_SpawnActorBase>(this), WeakMeshComp, WeakEventRef]
+			                               (AActor* Actor)
+			                               {
+				                               if (WeakThis.IsValid())
+				                               {
+					                               WeakThis->PreSpawnActor(Actor, WeakMeshComp.Get(), WeakEventRef.ToEventReference());
+					                               WeakThis->ApplySpawnProfile(Actor);
+				                               }
+			                               });
 		};
 
 	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
@@ -119,30 +210,57 @@ void UAnimNotifyState_SpawnActorBase::NotifyBegin(USkeletalMeshComponent* MeshCo
 	{
 		case EAnimActorClassLoadingBehaviour::BeginPlay_Async:
 		case EAnimActorClassLoadingBehaviour::FirstTimeRequested_Async:
-			if (SpawnableClass.IsValid())
+			if (Algo::AllOf(AssetsToLoad, [](const FSoftObjectPath& Path) { return Path.ResolveObject() != nullptr; }))
 			{
 				ClassLoaded();
 			}
 			else
 			{
-				StreamableManager.RequestAsyncLoad(SpawnableClass.ToSoftObjectPath(),
+				StreamableManager.RequestAsyncLoad(AssetsToLoad,
 					FStreamableDelegate::CreateWeakLambda(MeshComp, ClassLoaded));
 			}
 			break;
 		default:
-			StreamableManager.RequestSyncLoad(SpawnableClass.ToSoftObjectPath());
+			if (SubSys)
+			{
+				SubSys->SyncLoadAssets(AssetsToLoad);
+			}
+			else
+			{
+				StreamableManager.RequestSyncLoad(AssetsToLoad);
+			}
 			ClassLoaded();
 	}
 }
 
+void UAnimNotifyState_SpawnActorBase::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
+                                                 float FrameDeltaTime,
+                                                 const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
+
+	UAnimationActorSubsystem* SubSys = MeshComp && !IsSkippedOnServer(MeshComp) ? UAnimationActorSubsystem::Get(MeshComp) : nullptr;
+	if (SubSys && SubSys->IsCapturingNotifies())
+	{
+		SubSys->RecordNotifyEvent(AnimActorSys::ENotifyCaptureEvent::Tick, this, MeshComp, EventReference, FrameDeltaTime);
+	}
+}
+
 void UAnimNotifyState_SpawnActorBase::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
                                                 const FAnimNotifyEventReference& EventReference)
 {
 	Super::NotifyEnd(MeshComp, Animation, EventReference);
 
+	if (IsSkippedOnServer(MeshComp))
+	{
+		return;
+	}
+
 	const FGuid DeterministicGuid = ConstructDeterministicGuidFromComponent(MeshComp);
 	if (UAnimationActorSubsystem* SubSys = UAnimationActorSubsystem::Get(MeshComp))
-	{	
+	{
+		SubSys->RecordNotifyEvent(AnimActorSys::ENotifyCaptureEvent::End, this, MeshComp, EventReference);
+	
 #pragma region EditorOnlyPreview
 #if WITH_EDITOR
 		const FAnimNotifyEvent* Notify = EventReference.GetNotify();
@@ -154,7 +272,7 @@ void UAnimNotifyState_SpawnActorBase::NotifyEnd(USkeletalMeshComponent* MeshComp
 			const float ActiveMontagePosition = AnimInst->GetActiveMontageInstance()->GetPosition();
 			const bool bPlayheadIsWithinNotifyWindow = ActiveMontagePosition <= Notify->GetEndTriggerTime() &&
 					ActiveMontagePosition >= Notify->GetTriggerTime();
-			if (bPlayheadIsWithinNotifyWindow && SubSys->GetAnimActorByGuid(DeterministicGuid))
+			if (bPlayheadIsWithinNotifyWindow && SubSys->IsAnimActorRegistered(DeterministicGuid))
 			{
 				/** Info on what this does is above in NotifyBegin() in the EditorOnlyPreview region */
 				return;
@@ -187,10 +305,26 @@ void UAnimNotifyState_SpawnActorBase::PostEditChangeProperty(FPropertyChangedEve
 		if (UAnimationActorSubsystem* SubSys = UAnimationActorSubsystem::Get(CachedNotifyData.MeshComp.Get()))
 		{
 			SubSys->DestroyAnimActor(CachedGuid);
+			TArray<FSoftObjectPath> AssetsToLoad;
+			GatherAssetsToLoad(AssetsToLoad);
+			for (const FSoftObjectPath& Asset : AssetsToLoad)
+			{
+				Asset.TryLoad();
+			}
+			if (SpawnWithoutActor(SubSys, CachedNotifyData.MeshComp.Get(), CachedGuid,
+			                      CachedNotifyData.WeakEventReference.ToEventReference()))
+			{
+				continue;
+			}
 			if(AActor* SpawnedActor = SubSys->SpawnAnimActor(
 					GetSpawnableClassToLoad().LoadSynchronous(),
 					AttachTransform,
-					CachedGuid))
+					CachedGuid,
+					[this, &CachedNotifyData](AActor* Actor)
+					{
+						PreSpawnActor(Actor, CachedNotifyData.MeshComp.Get(), CachedNotifyData.WeakEventReference.ToEventReference());
+						ApplySpawnProfile(Actor);
+					}))
 			{
 				PostSpawnActor(SpawnedActor,
 				   SubSys,
@@ -204,6 +338,67 @@ void UAnimNotifyState_SpawnActorBase::PostEditChangeProperty(FPropertyChangedEve
 }
 #endif
 
+void UAnimNotifyState_SpawnActorBase::PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp,
+                                                    const FAnimNotifyEventReference& EventReference)
+{
+	if (Actor && Actor->GetRootComponent())
+	{
+		Actor->GetRootComponent()->SetMobility(EComponentMobility::Movable);
+	}
+}
+
+void UAnimNotifyState_SpawnActorBase::ApplySpawnProfile(AActor* Actor) const
+{
+	if (!Actor || SpawnProfile.IsEmpty())
+	{
+		return;
+	}
+	if (SpawnProfile.bDisableTick)
+	{
+		// Not registered yet for fresh spawns, where only bStartWithTickEnabled prevents the tick from being enabled.
+		Actor->PrimaryActorTick.bStartWithTickEnabled = false;
+		Actor->SetActorTickEnabled(false);
+	}
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [this](UPrimitiveComponent* Component)
+	{
+		ApplySpawnProfile(Component);
+	});
+}
+
+void UAnimNotifyState_SpawnActorBase::ApplySpawnProfile(UPrimitiveComponent* Component) const
+{
+	if (!Component)
+	{
+		return;
+	}
+	if (SpawnProfile.bDisableTick && !NeedsComponentTick(Component))
+	{
+		Component->PrimaryComponentTick.bStartWithTickEnabled = false;
+		Component->SetComponentTickEnabled(false);
+	}
+	if (SpawnProfile.bDisableOverlapEvents)
+	{
+		Component->SetGenerateOverlapEvents(false);
+	}
+	if (SpawnProfile.bDisablePhysics)
+	{
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+	if (SpawnProfile.bDisableShadows)
+	{
+		Component->SetCastShadow(false);
+	}
+	if (SpawnProfile.bDisableDecals)
+	{
+		Component->SetReceivesDecals(false);
+	}
+}
+
+bool UAnimNotifyState_SpawnActorBase::NeedsComponentTick(const UPrimitiveComponent* Component) const
+{
+	return Component->IsA<USkinnedMeshComponent>();
+}
+
 void UAnimNotifyState_SpawnActorBase::PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
                                                      USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
                                                      float TotalDuration,
@@ -213,36 +408,83 @@ void UAnimNotifyState_SpawnActorBase::PostSpawnActor(AActor* SpawnedActor, UAnim
 	{
 		return;
 	}
-	SpawnedActor->GetRootComponent()->SetMobility(EComponentMobility::Movable);
 	
 	// Only KeepRelative makes sense here. With AttachTransform being Identity this would be SnapToTarget,
 	// and KeepWorld is mostly meaningless here.
 	const FAttachmentTransformRules Rule = FAttachmentTransformRules(EAttachmentRule::KeepRelative,
 	                                                                 bWeldSimulatedBodies);
+	SpawnedActor->AttachToComponent(MeshComp, Rule, ResolveAttachBone(EventReference));
+}
+
+void UAnimNotifyState_SpawnActorBase::GatherSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies)
+{
+	const int32 FirstNewIndex = OutDependencies.Num();
+	OutDependencies.Add(GetSpawnableClassToLoad().ToSoftObjectPath());
+	GatherAssetsToLoad(OutDependencies);
+	for (int32 Index = OutDependencies.Num() - 1; Index >= FirstNewIndex; --Index)
+	{
+		if (OutDependencies[Index].IsNull())
+		{
+			OutDependencies.RemoveAt(Index);
+		}
+	}
+}
+
+void UAnimNotifyState_SpawnActorBase::GatherTaggedSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies,
+                                                                   TArray<FSoftObjectPath>& OutFallbackDependencies)
+{
+	GatherSpawnDependencies(OutDependencies);
+	GatherSpawnDependencies(OutFallbackDependencies);
+}
+
+bool UAnimNotifyState_SpawnActorBase::IsSkippedOnServer(const USkeletalMeshComponent* MeshComp) const
+{
+	return MeshComp && UAnimationActorSystemSettings::Get()->ShouldSkipNotify(MeshComp->GetNetMode(), bCosmetic);
+}
+
+FName UAnimNotifyState_SpawnActorBase::ResolveAttachBone(const FAnimNotifyEventReference& EventReference) const
+{
 	FName MirroredBone = NAME_None;
 	if(const UMirrorDataTable* MDT = EventReference.GetMirrorDataTable())
 	{
 		MirroredBone = MDT->GetSettingsMirrorName(AttachBone);
 	}
-	FName BoneToUse = MirroredBone == NAME_None ? AttachBone : MirroredBone;
-
-	SpawnedActor->AttachToComponent(MeshComp, Rule, BoneToUse);
+	return MirroredBone == NAME_None ? AttachBone : MirroredBone;
 }
 
 FString UAnimNotifyState_SpawnActorBase::BuildNotifyNameFromObject(UObject* Object) const
 {
 	static FString NoneString = FString(TEXT("None"));
+	return BuildNotifyNameFromObjectName(Object ? Object->GetName() : NoneString);
+}
+
+FString UAnimNotifyState_SpawnActorBase::BuildNotifyNameFromPath(const FSoftObjectPath& Path) const
+{
+	static FString NoneString = FString(TEXT("None"));
+	return BuildNotifyNameFromObjectName(Path.IsNull() ? NoneString : Path.GetAssetName());
+}
+
+FString UAnimNotifyState_SpawnActorBase::BuildNotifyNameFromObjectName(const FString& ObjectName) const
+{
 	if (AttachBone != NAME_None)
 	{
-		return FString::Printf(TEXT("Spawn %s on %s"), Object ? *Object->GetName() : *NoneString,
-		                       *AttachBone.ToString());
+		return FString::Printf(TEXT("Spawn %s on %s"), *ObjectName, *AttachBone.ToString());
 	}
-	return FString::Printf(TEXT("Spawn %s"), Object ? *Object->GetName() : *NoneString);
+	return FString::Printf(TEXT("Spawn %s"), *ObjectName);
 }
 
 FGuid UAnimNotifyState_SpawnActorBase::ConstructDeterministicGuidFromComponent(USkeletalMeshComponent* InComponent) const
 {
 	// Ideally, I'd just get the ActorGuid, but sadly that one is editor-only, so no use for my purposes...
-	const FGuid DynamicPartialAnimActorGuid = FGuid::NewDeterministicGuid(InComponent->GetPathName());
+	// Object index and serial number identify the component for its whole lifetime, same as FObjectKey does.
+	// Unlike the path name, they're available without building and hashing a string on every call.
+	// The serial number is only allocated the first time and cached by the object array afterward.
+	if (!InComponent)
+	{
+		return StaticPartialAnimActorGuid;
+	}
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(InComponent);
+	const int32 SerialNumber = GUObjectArray.AllocateSerialNumber(ObjectIndex);
+	const FGuid DynamicPartialAnimActorGuid = FGuid(ObjectIndex, SerialNumber, 0, 0);
 	return FGuid::Combine(StaticPartialAnimActorGuid, DynamicPartialAnimActorGuid);
 }
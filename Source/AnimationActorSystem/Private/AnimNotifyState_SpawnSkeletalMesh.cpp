@@ -3,11 +3,49 @@
 
 #include "AnimNotifyState_SpawnSkeletalMesh.h"
 
+#include "AnimationActorAnimInstance.h"
+#include "AnimationActorCopyPoseAnimInstance.h"
+#include "AnimationActorSkeletalMeshComponent.h"
 #include "AnimationActorSubsystem.h"
 #include "AnimationActorSystem.h"
-#include "Animation/AnimNotifyLibrary.h"
 #include "Animation/AnimSequenceBase.h"
-#include "Animation/AnimSingleNodeInstance.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+
+bool UAnimNotifyState_SpawnSkeletalMesh::SpawnWithoutActor(UAnimationActorSubsystem* Subsystem, USkeletalMeshComponent* MeshComp,
+                                                           const FGuid& Guid, const FAnimNotifyEventReference& EventReference)
+{
+	if (SpawnMode != EAnimActorSkeletalMeshSpawnMode::Component)
+	{
+		return false;
+	}
+
+	if (ShouldUseStaticMeshFallback())
+	{
+		Subsystem->SpawnAnimComponent(UStaticMeshComponent::StaticClass(), MeshComp, ResolveAttachBone(EventReference),
+		                              AttachTransform, bWeldSimulatedBodies, Guid,
+		                              [this](UPrimitiveComponent* Comp)
+		                              {
+			                              ConfigureFallbackComponent(CastChecked<UStaticMeshComponent>(Comp));
+			                              ApplySpawnProfile(Comp);
+		                              });
+		return true;
+	}
+
+	if (USkeletalMeshComponent* Comp = Cast<USkeletalMeshComponent>(Subsystem->SpawnAnimComponent(
+		UAnimationActorSkeletalMeshComponent::StaticClass(), MeshComp, ResolveAttachBone(EventReference),
+		AttachTransform, bWeldSimulatedBodies, Guid,
+		[this](UPrimitiveComponent* NewComp)
+		{
+			ConfigureMeshComponent(CastChecked<USkeletalMeshComponent>(NewComp));
+			ApplySpawnProfile(NewComp);
+		})))
+	{
+		ConfigureAnimation(Comp, MeshComp);
+	}
+	return true;
+}
 
 void UAnimNotifyState_SpawnSkeletalMesh::PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
                                                         USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
@@ -15,20 +53,80 @@ void UAnimNotifyState_SpawnSkeletalMesh::PostSpawnActor(AActor* SpawnedActor, UA
 {
 	Super::PostSpawnActor(SpawnedActor, Subsystem, MeshComp, Animation, TotalDuration, EventReference);
 
-	const ASkeletalMeshActor* SKMA = CastChecked<ASkeletalMeshActor>(SpawnedActor);
+	if (const ASkeletalMeshActor* SKMA = Cast<ASkeletalMeshActor>(SpawnedActor))
+	{
+		ConfigureAnimation(SKMA->GetSkeletalMeshComponent(), MeshComp);
+	}
+}
+
+void UAnimNotifyState_SpawnSkeletalMesh::PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp,
+                                                       const FAnimNotifyEventReference& EventReference)
+{
+	Super::PreSpawnActor(Actor, MeshComp, EventReference);
+
+	// The fallback may have been toggled while the spawn was pending, so go by what actually got spawned.
+	if (const AStaticMeshActor* SMA = Cast<AStaticMeshActor>(Actor))
+	{
+		ConfigureFallbackComponent(SMA->GetStaticMeshComponent());
+		return;
+	}
+
+	const ASkeletalMeshActor* SKMA = CastChecked<ASkeletalMeshActor>(Actor);
 	USkeletalMeshComponent* Comp = SKMA->GetSkeletalMeshComponent();
 	check(Comp)
-	Comp->SetSkeletalMesh(MeshToSpawn);
+	ConfigureMeshComponent(Comp);
+}
+
+void UAnimNotifyState_SpawnSkeletalMesh::ConfigureMeshComponent(USkeletalMeshComponent* Comp) const
+{
+	Comp->SetSkeletalMesh(MeshToSpawn.Get());
+
+	if(bOverrideCollisionProfile)
+	{
+		Comp->SetCollisionProfileName(CollisionProfileOverride.Name, true);
+	}
 	
+	Comp->SetCanEverAffectNavigation(UAnimationActorSystemSettings::Get()->bSkeletalCanAffectNavigation);
+}
+
+void UAnimNotifyState_SpawnSkeletalMesh::ConfigureAnimation(USkeletalMeshComponent* Comp, USkeletalMeshComponent* MeshComp) const
+{
+	// Followers are driven by their leader already.
+	if (UAnimationActorSkeletalMeshComponent* AnimActorComp = Cast<UAnimationActorSkeletalMeshComponent>(Comp))
+	{
+		AnimActorComp->SetUpdateRateSource(AnimationMode != EAnimActorAnimationMode::PoseLeader ? MeshComp : nullptr);
+	}
+	else if (AnimationMode != EAnimActorAnimationMode::PoseLeader)
+	{
+		// Only the component of the Actor spawn mode can be of another class, if SkeletalMeshActorClass isn't changed from the default.
+		static bool bWarnedAboutComponentClass = false;
+		const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+		if (!bWarnedAboutComponentClass && (Settings->bInheritOwnerUpdateRate || Settings->bFollowOwnerLOD))
+		{
+			bWarnedAboutComponentClass = true;
+			UE_LOG(LogAnimActorSys, Warning, TEXT("%s spawned a %s, which can't inherit the update rate and LOD of the mesh that spawned it."
+				" Use AnimationActorSkeletalMeshActor as SkeletalMeshActorClass for that, or disable bInheritOwnerUpdateRate and bFollowOwnerLOD."),
+				*GetName(), *Comp->GetClass()->GetName())
+		}
+	}
+
 	switch (AnimationMode)
 	{
 	case EAnimActorAnimationMode::AnimSequence:
 		{
-			if(AnimationToPlay)
+			if(UAnimSequenceBase* Anim = AnimationToPlay.Get())
 			{
-				Comp->PlayAnimation(AnimationToPlay, bOverrideLoopBehaviour ? bLoopAnimation : AnimationToPlay->bLoop);
-				Comp->SetPlayRate(0);
-				Comp->InitAnim(false);
+				Comp->SetAnimInstanceClass(UAnimationActorAnimInstance::StaticClass());
+				if (UAnimationActorAnimInstance* AnimInstance = Cast<UAnimationActorAnimInstance>(Comp->GetAnimInstance()))
+				{
+					AnimInstance->SetAnimationAsset(Anim, bOverrideLoopBehaviour ? bLoopAnimation : Anim->bLoop);
+					AnimInstance->SetPlaying(true);
+					AnimInstance->InitSync(MeshComp, this);
+					if (UAnimationActorSubsystem* Subsystem = UAnimationActorSubsystem::Get(Comp))
+					{
+						Subsystem->JoinSharedPoseGroup(Comp, Anim);
+					}
+				}
 			}
 			break;
 		}
@@ -39,75 +137,89 @@ void UAnimNotifyState_SpawnSkeletalMesh::PostSpawnActor(AActor* SpawnedActor, UA
 		}
 	case EAnimActorAnimationMode::AnimBlueprint:
 		{
-			Comp->SetAnimInstanceClass(AnimationBlueprint);
+			Comp->SetAnimInstanceClass(AnimationBlueprint.Get());
+			break;
+		}
+	case EAnimActorAnimationMode::CopyPose:
+		{
+			Comp->SetAnimInstanceClass(UAnimationActorCopyPoseAnimInstance::StaticClass());
+			if (UAnimationActorCopyPoseAnimInstance* AnimInstance = Cast<UAnimationActorCopyPoseAnimInstance>(Comp->GetAnimInstance()))
+			{
+				AnimInstance->SetSource(MeshComp);
+			}
+			break;
 		}
 	}
-	
+}
+
+void UAnimNotifyState_SpawnSkeletalMesh::ConfigureFallbackComponent(UStaticMeshComponent* Comp) const
+{
+	Comp->SetStaticMesh(StaticMeshFallback.Get());
 	if(bOverrideCollisionProfile)
 	{
 		Comp->SetCollisionProfileName(CollisionProfileOverride.Name, true);
 	}
-	
+
 	Comp->SetCanEverAffectNavigation(UAnimationActorSystemSettings::Get()->bSkeletalCanAffectNavigation);
 }
 
+bool UAnimNotifyState_SpawnSkeletalMesh::NeedsComponentTick(const UPrimitiveComponent* Component) const
+{
+	// Followers are updated by their leader.
+	return Super::NeedsComponentTick(Component) && AnimationMode != EAnimActorAnimationMode::PoseLeader;
+}
+
+const UObject* UAnimNotifyState_SpawnSkeletalMesh::GetConcurrencyAsset() const
+{
+	if (ShouldUseStaticMeshFallback())
+	{
+		return StaticMeshFallback.Get();
+	}
+	return MeshToSpawn.Get();
+}
+
 FString UAnimNotifyState_SpawnSkeletalMesh::GetNotifyName_Implementation() const
 {
-	return BuildNotifyNameFromObject(MeshToSpawn);
+	return BuildNotifyNameFromPath(MeshToSpawn.ToSoftObjectPath());
 }
 
-void UAnimNotifyState_SpawnSkeletalMesh::NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime,
-	const FAnimNotifyEventReference& EventReference)
+void UAnimNotifyState_SpawnSkeletalMesh::GatherTaggedSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies,
+                                                                      TArray<FSoftObjectPath>& OutFallbackDependencies)
 {
-	Super::NotifyTick(MeshComp, Animation, FrameDeltaTime, EventReference);
-	
-	if (!MeshComp || !Animation)
+	OutDependencies.Add(GetSpawnableClass(false).ToSoftObjectPath());
+	GatherMeshAssets(OutDependencies, false);
+
+	const bool bHasFallback = !StaticMeshFallback.IsNull();
+	OutFallbackDependencies.Add(GetSpawnableClass(bHasFallback).ToSoftObjectPath());
+	GatherMeshAssets(OutFallbackDependencies, bHasFallback);
+}
+
+TSoftClassPtr<AActor> UAnimNotifyState_SpawnSkeletalMesh::GetSpawnableClass(const bool bFallback) const
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	return bFallback
+		? TSoftClassPtr<AActor>(Settings->StaticMeshActorClass.ToSoftObjectPath())
+		: TSoftClassPtr<AActor>(Settings->SkeletalMeshActorClass.ToSoftObjectPath());
+}
+
+void UAnimNotifyState_SpawnSkeletalMesh::GatherMeshAssets(TArray<FSoftObjectPath>& OutAssets, const bool bFallback) const
+{
+	if (bFallback)
 	{
+		OutAssets.Add(StaticMeshFallback.ToSoftObjectPath());
 		return;
 	}
+	
+	OutAssets.Add(MeshToSpawn.ToSoftObjectPath());
 	switch (AnimationMode)
 	{
 	case EAnimActorAnimationMode::AnimSequence:
-		{
-			if (const UAnimationActorSubsystem* Subsystem = UAnimationActorSubsystem::Get(MeshComp))
-			{
-				ASkeletalMeshActor* AnimActor = Cast<ASkeletalMeshActor>(Subsystem->GetAnimActorByGuid(ConstructDeterministicGuidFromComponent(MeshComp)));
-				if (!AnimActor
-					|| !AnimActor->GetSkeletalMeshComponent()
-					|| !AnimActor->GetSkeletalMeshComponent()->GetSingleNodeInstance())
-				{
-					return;
-				}
-#if WITH_EDITOR
-				// Handle case of being a preview for an AnimMontage
-				const FAnimNotifyEvent* NotifyEvent = EventReference.GetNotify();
-				const UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
-				if (NotifyEvent && AnimInstance && AnimInstance->GetActiveMontageInstance())
-				{
-					const FAnimMontageInstance* ActiveMontage = AnimInstance->GetActiveMontageInstance();
-					const float ActiveMontagePosition = ActiveMontage->GetPosition();
-					const float NotifyTriggerTime = NotifyEvent->GetTriggerTime();
-					const bool bPlayheadIsWithinNotifyWindow = ActiveMontagePosition <= NotifyEvent->GetEndTriggerTime() &&
-							ActiveMontagePosition >= NotifyTriggerTime;
-					if (bPlayheadIsWithinNotifyWindow)
-					{
-						AnimActor->GetSkeletalMeshComponent()->GetSingleNodeInstance()->SetPosition(FMath::Max(0.f, ActiveMontagePosition-NotifyTriggerTime));
-						return;
-					}
-				}
-#endif
-
-				// Keep playing animation in sync with the animation that spawned the actor.
-				// This is to prevent situations where the spawning actor has a separate time dilation set from the world
-				// from de-syncing the animation of this actor.
-				const float ElapsedTime = UAnimNotifyLibrary::GetCurrentAnimationNotifyStateTime(EventReference);
-				AnimActor->GetSkeletalMeshComponent()->GetSingleNodeInstance()->SetPosition(ElapsedTime);
-			}
-			return;
-		}
+		OutAssets.Add(AnimationToPlay.ToSoftObjectPath());
+		break;
+	case EAnimActorAnimationMode::AnimBlueprint:
+		OutAssets.Add(AnimationBlueprint.ToSoftObjectPath());
+		break;
 	default:
-		{
-			return;
-		}
+		break;
 	}
 }
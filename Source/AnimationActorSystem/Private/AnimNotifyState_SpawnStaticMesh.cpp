@@ -3,16 +3,70 @@
 
 #include "AnimNotifyState_SpawnStaticMesh.h"
 
-void UAnimNotifyState_SpawnStaticMesh::PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
-                                                      USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
-                                                      const FAnimNotifyEventReference& EventReference)
+#include "AnimationActorSubsystem.h"
+#include "AnimationActorSystem.h"
+
+bool UAnimNotifyState_SpawnStaticMesh::SpawnWithoutActor(UAnimationActorSubsystem* Subsystem, USkeletalMeshComponent* MeshComp,
+                                                         const FGuid& Guid, const FAnimNotifyEventReference& EventReference)
 {
-	Super::PostSpawnActor(SpawnedActor, Subsystem, MeshComp, Animation, TotalDuration, EventReference);
+	// Instance transforms follow their bones in the subsystem's Tick, which doesn't run in animation editor previews.
+	// Attached components follow on their own, so they stand in for the instances there.
+	const bool bInstanced = SpawnMode == EAnimActorStaticMeshSpawnMode::Instanced;
+	const bool bCanBatchInstances = MeshComp->GetWorld() && MeshComp->GetWorld()->IsGameWorld();
+	if (bInstanced && bCanBatchInstances)
+	{
+		if (!Subsystem->AddAnimActorInstance(MeshToSpawn.Get(), MeshComp, ResolveAttachBone(EventReference), AttachTransform, Guid))
+		{
+			// Falling back to an actor wouldn't have a mesh either, so nothing is spawned for this notify.
+			UE_LOG(LogAnimActorSys, Warning, TEXT("%s failed to add an instance of %s."), *GetName(), *GetNameSafe(MeshToSpawn.Get()))
+			Subsystem->CancelAnimActor(Guid);
+		}
+		return true;
+	}
+	
+	switch (SpawnMode)
+	{
+	case EAnimActorStaticMeshSpawnMode::Instanced:
+	case EAnimActorStaticMeshSpawnMode::Component:
+		{
+			const UPrimitiveComponent* SpawnedComp = Subsystem->SpawnAnimComponent(
+				UStaticMeshComponent::StaticClass(), MeshComp, ResolveAttachBone(EventReference),
+				AttachTransform, bWeldSimulatedBodies, Guid,
+				[this, bInstanced](UPrimitiveComponent* Comp)
+				{
+					ConfigureMeshComponent(CastChecked<UStaticMeshComponent>(Comp));
+					ApplySpawnProfile(Comp);
+					if (bInstanced)
+					{
+						// Just like the instances it replaces.
+						Comp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+					}
+				});
+			if (!SpawnedComp)
+			{
+				Subsystem->CancelAnimActor(Guid);
+			}
+			return true;
+		}
+	default:
+		return false;
+	}
+}
 
-	const AStaticMeshActor* SKMA = CastChecked<AStaticMeshActor>(SpawnedActor);
+void UAnimNotifyState_SpawnStaticMesh::PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp,
+                                                     const FAnimNotifyEventReference& EventReference)
+{
+	Super::PreSpawnActor(Actor, MeshComp, EventReference);
+
+	const AStaticMeshActor* SKMA = CastChecked<AStaticMeshActor>(Actor);
 	UStaticMeshComponent* Comp = SKMA->GetStaticMeshComponent();
 	check(Comp)
-	Comp->SetStaticMesh(MeshToSpawn);
+	ConfigureMeshComponent(Comp);
+}
+
+void UAnimNotifyState_SpawnStaticMesh::ConfigureMeshComponent(UStaticMeshComponent* Comp) const
+{
+	Comp->SetStaticMesh(MeshToSpawn.Get());
 	if(bOverrideCollisionProfile)
 	{
 		Comp->SetCollisionProfileName(CollisionProfileOverride.Name, true);
@@ -23,5 +77,5 @@ void UAnimNotifyState_SpawnStaticMesh::PostSpawnActor(AActor* SpawnedActor, UAni
 
 FString UAnimNotifyState_SpawnStaticMesh::GetNotifyName_Implementation() const
 {
-	return BuildNotifyNameFromObject(MeshToSpawn);
+	return BuildNotifyNameFromPath(MeshToSpawn.ToSoftObjectPath());
 }
@@ -0,0 +1,127 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorAnimInstance.h"
+
+#include "AnimationActorSystemStats.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimNotifyLibrary.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void FAnimationActorAnimInstanceProxy::UpdateAnimationNode(const FAnimationUpdateContext& InContext)
+{
+	if (bHasSyncTime && AnimLength > 0.f)
+	{
+		const bool bLoop = IsLooping();
+		const float TargetTime = bLoop ? FMath::Fmod(SyncTime, AnimLength) : FMath::Min(SyncTime, AnimLength);
+		float MoveDelta = TargetTime - GetCurrentTime();
+		if (bLoop && MoveDelta < 0.f && SyncTime > PreviousSyncTime)
+		{
+			MoveDelta += AnimLength;
+		}
+
+		const float DeltaSeconds = InContext.GetDeltaTime() * AnimRateScale;
+		if (MoveDelta < 0.f || DeltaSeconds <= UE_KINDA_SMALL_NUMBER)
+		{
+			// Jumped back, e.g. by scrubbing in the editor. Nothing in between should fire.
+			SetCurrentTime(TargetTime);
+			SetPlayRate(0.f);
+		}
+		else
+		{
+			SetPlayRate(MoveDelta / DeltaSeconds);
+		}
+	}
+	else
+	{
+		SetPlayRate(0.f);
+	}
+	FAnimSingleNodeInstanceProxy::UpdateAnimationNode(InContext);
+}
+
+void UAnimationActorAnimInstance::InitSync(USkeletalMeshComponent* InSyncSource, const UAnimNotifyState* Notify)
+{
+	USkeletalMeshComponent* OwningComp = GetSkelMeshComponent();
+	if (USkeletalMeshComponent* PreviousSource = SyncSource.Get(); PreviousSource && PreviousSource != InSyncSource)
+	{
+		OwningComp->RemoveTickPrerequisiteComponent(PreviousSource);
+	}
+	// The owner has to update its notify states first, otherwise the time is a frame behind.
+	if (InSyncSource)
+	{
+		OwningComp->AddTickPrerequisiteComponent(InSyncSource);
+	}
+	SyncSource = InSyncSource;
+	SyncNotify = Notify;
+
+	FAnimationActorAnimInstanceProxy& Proxy = GetProxyOnGameThread<FAnimationActorAnimInstanceProxy>();
+	Proxy.bHasSyncTime = false;
+	Proxy.SyncTime = Proxy.PreviousSyncTime = 0.f;
+	if (const UAnimSequenceBase* Sequence = Cast<UAnimSequenceBase>(CurrentAsset))
+	{
+		Proxy.AnimLength = Sequence->GetPlayLength();
+		Proxy.AnimRateScale = Sequence->RateScale;
+	}
+	SetPlayRate(0.f);
+}
+
+void UAnimationActorAnimInstance::PreUpdateAnimation(const float DeltaSeconds)
+{
+	{
+		SCOPE_CYCLE_COUNTER(STAT_AnimActorSys_NotifyTickSync);
+
+		float Time = 0.f;
+		const bool bHasTime = GetNotifyStateTime(Time);
+		if (bHasTime && CurrentAsset && CurrentAsset->IsA<UAnimMontage>())
+		{
+			// Montages advance on the game thread anyway, so there's nothing to gain from syncing them in the proxy.
+			SetPosition(Time);
+		}
+		else
+		{
+			FAnimationActorAnimInstanceProxy& Proxy = GetProxyOnGameThread<FAnimationActorAnimInstanceProxy>();
+			Proxy.PreviousSyncTime = Proxy.SyncTime;
+			Proxy.SyncTime = bHasTime ? Time : Proxy.SyncTime;
+			Proxy.bHasSyncTime = bHasTime;
+		}
+	}
+	Super::PreUpdateAnimation(DeltaSeconds);
+}
+
+bool UAnimationActorAnimInstance::GetNotifyStateTime(float& OutTime) const
+{
+	const USkeletalMeshComponent* Source = SyncSource.Get();
+	const UAnimInstance* SourceInstance = Source ? Source->GetAnimInstance() : nullptr;
+	if (!SourceInstance || !SyncNotify)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < SourceInstance->ActiveAnimNotifyState.Num(); ++Index)
+	{
+		const FAnimNotifyEvent& NotifyEvent = SourceInstance->ActiveAnimNotifyState[Index];
+		if (NotifyEvent.NotifyStateClass != SyncNotify || !SourceInstance->ActiveAnimNotifyEventReference.IsValidIndex(Index))
+		{
+			continue;
+		}
+#if WITH_EDITOR
+		// Handle case of being a preview for an AnimMontage
+		if (const FAnimMontageInstance* ActiveMontage = SourceInstance->GetActiveMontageInstance())
+		{
+			const float ActiveMontagePosition = ActiveMontage->GetPosition();
+			const float NotifyTriggerTime = NotifyEvent.GetTriggerTime();
+			if (ActiveMontagePosition <= NotifyEvent.GetEndTriggerTime() && ActiveMontagePosition >= NotifyTriggerTime)
+			{
+				OutTime = FMath::Max(0.f, ActiveMontagePosition - NotifyTriggerTime);
+				return true;
+			}
+		}
+#endif
+		// Follow the animation that spawned the mesh rather than our own delta time,
+		// so a separate time dilation on the spawning actor doesn't de-sync the two.
+		OutTime = UAnimNotifyLibrary::GetCurrentAnimationNotifyStateTime(SourceInstance->ActiveAnimNotifyEventReference[Index]);
+		return true;
+	}
+	return false;
+}
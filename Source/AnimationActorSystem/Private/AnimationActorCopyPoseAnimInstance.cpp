@@ -0,0 +1,98 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorCopyPoseAnimInstance.h"
+
+#include "AnimationActorSubsystem.h"
+#include "Animation/AnimNodeBase.h"
+#include "BonePose.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void FAnimationActorCopyPoseProxy::PreUpdate(UAnimInstance* InAnimInstance, const float DeltaSeconds)
+{
+	FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	UAnimationActorCopyPoseAnimInstance* AnimInstance = CastChecked<UAnimationActorCopyPoseAnimInstance>(InAnimInstance);
+	AnimInstance->UpdateBoneIndexMap(*this);
+
+	const USkeletalMeshComponent* PoseSource = AnimInstance->GetPoseSource();
+	if (PoseSource && BoneIndexMap.IsValid() && BoneIndexMap->IsReady())
+	{
+		SourceTransforms = PoseSource->GetComponentSpaceTransforms();
+	}
+	else
+	{
+		SourceTransforms.Reset();
+	}
+}
+
+bool FAnimationActorCopyPoseProxy::Evaluate(FPoseContext& Output)
+{
+	Output.ResetToRefPose();
+	if (SourceTransforms.IsEmpty())
+	{
+		return true;
+	}
+
+	const FBoneContainer& BoneContainer = Output.Pose.GetBoneContainer();
+	const TArray<int32>& SourceBoneIndices = BoneIndexMap->SourceBoneIndices;
+
+	FCSPose<FCompactPose> ComponentSpacePose;
+	ComponentSpacePose.InitPose(Output.Pose);
+	for (const FCompactPoseBoneIndex BoneIndex : Output.Pose.ForEachBoneIndex())
+	{
+		const int32 MeshBoneIndex = BoneContainer.MakeMeshPoseIndex(BoneIndex).GetInt();
+		const int32 SourceBoneIndex = SourceBoneIndices.IsValidIndex(MeshBoneIndex) ? SourceBoneIndices[MeshBoneIndex] : INDEX_NONE;
+		if (SourceTransforms.IsValidIndex(SourceBoneIndex))
+		{
+			ComponentSpacePose.SetComponentSpaceTransform(BoneIndex, SourceTransforms[SourceBoneIndex]);
+		}
+	}
+	FCSPose<FCompactPose>::ConvertComponentPosesToLocalPoses(MoveTemp(ComponentSpacePose), Output.Pose);
+	return true;
+}
+
+void UAnimationActorCopyPoseAnimInstance::SetSource(USkeletalMeshComponent* InSource)
+{
+	USkeletalMeshComponent* OwningComp = GetSkelMeshComponent();
+	if (USkeletalMeshComponent* PreviousSource = Source.Get(); PreviousSource && PreviousSource != InSource)
+	{
+		OwningComp->RemoveTickPrerequisiteComponent(PreviousSource);
+	}
+	// The source has to be done evaluating before we copy its pose.
+	if (InSource)
+	{
+		OwningComp->AddTickPrerequisiteComponent(InSource);
+	}
+	Source = InSource;
+	UpdateBoneIndexMap(GetProxyOnGameThread<FAnimationActorCopyPoseProxy>());
+}
+
+USkeletalMeshComponent* UAnimationActorCopyPoseAnimInstance::GetPoseSource() const
+{
+	USkeletalMeshComponent* SourceComp = Source.Get();
+	if (SourceComp && SourceComp->GetLeaderPoseComponent().IsValid())
+	{
+		return Cast<USkeletalMeshComponent>(SourceComp->GetLeaderPoseComponent().Get());
+	}
+	return SourceComp;
+}
+
+void UAnimationActorCopyPoseAnimInstance::UpdateBoneIndexMap(FAnimationActorCopyPoseProxy& Proxy)
+{
+	const USkeletalMeshComponent* PoseSource = GetPoseSource();
+	const USkeletalMesh* SourceMesh = PoseSource ? PoseSource->GetSkeletalMeshAsset() : nullptr;
+	const USkeletalMesh* TargetMesh = GetSkelMeshComponent()->GetSkeletalMeshAsset();
+
+	if (Proxy.BoneIndexMap.IsValid() && MappedSourceMesh == FObjectKey(SourceMesh) && MappedTargetMesh == FObjectKey(TargetMesh))
+	{
+		return;
+	}
+	MappedSourceMesh = SourceMesh;
+	MappedTargetMesh = TargetMesh;
+
+	UAnimationActorSubsystem* Subsystem = UAnimationActorSubsystem::Get(GetSkelMeshComponent());
+	Proxy.BoneIndexMap = Subsystem && SourceMesh && TargetMesh
+		? TSharedPtr<const AnimActorSys::FBoneIndexMap>(Subsystem->GetBoneIndexMap(SourceMesh, TargetMesh))
+		: nullptr;
+}
@@ -0,0 +1,151 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorMemoryReport.h"
+
+#include "Misc/FileHelper.h"
+#include "UObject/Object.h"
+
+namespace AnimActorSys
+{
+	FMemoryReportRow& FMemoryReport::FindOrAddRow(const EMemoryReportCategory Category, const FString& ClassName,
+	                                              const FString& AssetName)
+	{
+		const FString Key = FString::Printf(TEXT("%d|%s|%s"), static_cast<int32>(Category), *ClassName, *AssetName);
+		const int32 RowIndex = RowIndices.FindOrAdd(Key, Rows.Num());
+		if (RowIndex == Rows.Num())
+		{
+			FMemoryReportRow& NewRow = Rows.AddDefaulted_GetRef();
+			NewRow.Category = Category;
+			NewRow.Class = ClassName;
+			NewRow.Asset = AssetName;
+		}
+		return Rows[RowIndex];
+	}
+
+	void FMemoryReport::Add(const EMemoryReportCategory Category, const UObject* Object, const FString& ClassName,
+	                        const FString& AssetName, const double LastUsedSecondsAgo, const EResourceSizeMode::Type SizeMode)
+	{
+		FMemoryReportRow& Row = FindOrAddRow(Category, ClassName, AssetName);
+		Row.Count++;
+		if (LastUsedSecondsAgo >= 0.0)
+		{
+			Row.LastUsedSecondsAgo = Row.LastUsedSecondsAgo < 0.0 ? LastUsedSecondsAgo : FMath::Min(Row.LastUsedSecondsAgo, LastUsedSecondsAgo);
+		}
+		AddResourceSize(Row, Object, SizeMode);
+	}
+
+	void FMemoryReport::AddResourceSize(FMemoryReportRow& Row, const UObject* Object, const EResourceSizeMode::Type SizeMode)
+	{
+		if (!Object)
+		{
+			return;
+		}
+		FResourceSizeEx ResourceSize(SizeMode);
+		const_cast<UObject*>(Object)->GetResourceSizeEx(ResourceSize);
+		Row.CpuBytes += static_cast<int64>(ResourceSize.GetDedicatedSystemMemoryBytes() + ResourceSize.GetUnknownMemoryBytes());
+		Row.GpuBytes += static_cast<int64>(ResourceSize.GetDedicatedVideoMemoryBytes());
+	}
+
+	void FMemoryReport::Sort(const EMemoryReportSortBy SortBy)
+	{
+		Rows.StableSort([SortBy](const FMemoryReportRow& A, const FMemoryReportRow& B)
+		{
+			switch (SortBy)
+			{
+				case EMemoryReportSortBy::CpuBytes:
+					return A.CpuBytes > B.CpuBytes;
+				case EMemoryReportSortBy::GpuBytes:
+					return A.GpuBytes > B.GpuBytes;
+				case EMemoryReportSortBy::Count:
+					return A.Count > B.Count;
+				case EMemoryReportSortBy::Age:
+					return A.LastUsedSecondsAgo > B.LastUsedSecondsAgo;
+				case EMemoryReportSortBy::Name:
+					return A.Class == B.Class ? A.Asset < B.Asset : A.Class < B.Class;
+				default:
+					return A.CpuBytes + A.GpuBytes > B.CpuBytes + B.GpuBytes;
+			}
+		});
+		RowIndices.Reset();
+	}
+
+	int64 FMemoryReport::GetTotalBytes(const EMemoryReportCategory Category) const
+	{
+		int64 TotalBytes = 0;
+		for (const FMemoryReportRow& Row : Rows)
+		{
+			if (Row.Category == Category)
+			{
+				TotalBytes += Row.CpuBytes + Row.GpuBytes;
+			}
+		}
+		return TotalBytes;
+	}
+
+	void FMemoryReport::Log(FOutputDevice& Ar) const
+	{
+		Ar.Logf(TEXT("AnimActor memory report for %s"), *World);
+		for (uint8 Category = 0; Category <= static_cast<uint8>(EMemoryReportCategory::ReferencedAsset); ++Category)
+		{
+			Ar.Logf(TEXT("  %s: %.2f MB"), LexCategory(static_cast<EMemoryReportCategory>(Category)),
+			        GetTotalBytes(static_cast<EMemoryReportCategory>(Category)) / (1024.0 * 1024.0));
+		}
+		Ar.Logf(TEXT("%-16s %6s %10s %10s %8s  %s"), TEXT("Category"), TEXT("Count"), TEXT("CPU KB"), TEXT("GPU KB"), TEXT("Age s"), TEXT("Class / Asset"));
+		for (const FMemoryReportRow& Row : Rows)
+		{
+			Ar.Logf(TEXT("%-16s %6d %10.1f %10.1f %8s  %s%s%s"), LexCategory(Row.Category), Row.Count,
+			        Row.CpuBytes / 1024.0, Row.GpuBytes / 1024.0,
+			        Row.LastUsedSecondsAgo < 0.0 ? TEXT("-") : *FString::Printf(TEXT("%.1f"), Row.LastUsedSecondsAgo),
+			        *Row.Class, Row.Asset.IsEmpty() ? TEXT("") : TEXT(" / "), *Row.Asset);
+		}
+	}
+
+	bool FMemoryReport::SaveCsv(const FString& FilePath) const
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Rows.Num() + 1);
+		Lines.Add(TEXT("Category,Class,Asset,Count,CpuBytes,GpuBytes,LastUsedSecondsAgo"));
+		for (const FMemoryReportRow& Row : Rows)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,\"%s\",\"%s\",%d,%lld,%lld,%s"), LexCategory(Row.Category), *Row.Class, *Row.Asset,
+			                          Row.Count, Row.CpuBytes, Row.GpuBytes,
+			                          Row.LastUsedSecondsAgo < 0.0 ? TEXT("") : *FString::Printf(TEXT("%.3f"), Row.LastUsedSecondsAgo)));
+		}
+		return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+	}
+
+	const TCHAR* FMemoryReport::LexCategory(const EMemoryReportCategory Category)
+	{
+		switch (Category)
+		{
+			case EMemoryReportCategory::Live:				return TEXT("Live");
+			case EMemoryReportCategory::Pooled:				return TEXT("Pooled");
+			case EMemoryReportCategory::Lingering:			return TEXT("Lingering");
+			case EMemoryReportCategory::ReferencedClass:	return TEXT("ReferencedClass");
+			case EMemoryReportCategory::ReferencedAsset:	return TEXT("ReferencedAsset");
+		}
+		return TEXT("Unknown");
+	}
+
+	bool FMemoryReport::ParseSortBy(const FString& String, EMemoryReportSortBy& OutSortBy)
+	{
+		static const TPair<const TCHAR*, EMemoryReportSortBy> Names[] = {
+			{TEXT("Total"), EMemoryReportSortBy::TotalBytes},
+			{TEXT("Cpu"), EMemoryReportSortBy::CpuBytes},
+			{TEXT("Gpu"), EMemoryReportSortBy::GpuBytes},
+			{TEXT("Count"), EMemoryReportSortBy::Count},
+			{TEXT("Age"), EMemoryReportSortBy::Age},
+			{TEXT("Name"), EMemoryReportSortBy::Name},
+		};
+		for (const auto& [Name, SortBy] : Names)
+		{
+			if (String.Equals(Name, ESearchCase::IgnoreCase))
+			{
+				OutSortBy = SortBy;
+				return true;
+			}
+		}
+		return false;
+	}
+}
@@ -0,0 +1,164 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorNotifyCapture.h"
+
+#include "AnimationActorSystem.h"
+#include "AnimNotifyState_SpawnActorBase.h"
+#include "Animation/AnimNotifyQueue.h"
+#include "Animation/MirrorDataTable.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace AnimActorSys
+{
+	namespace NotifyCapture
+	{
+		/** "AACP" */
+		constexpr uint32 Magic = 0x50434141;
+		constexpr int32 Version = 1;
+	}
+
+	void FNotifyCapture::RecordFrame(const float DeltaTime)
+	{
+		Events.Add({ENotifyCaptureEvent::Frame, INDEX_NONE, DeltaTime});
+	}
+
+	void FNotifyCapture::RecordEvent(const ENotifyCaptureEvent Type, const UAnimNotifyState_SpawnActorBase* Notify,
+	                                 const USkeletalMeshComponent* MeshComp, const FAnimNotifyEventReference& EventReference,
+	                                 const float Value)
+	{
+		const FGuid Guid = Notify->ConstructDeterministicGuidFromComponent(const_cast<USkeletalMeshComponent*>(MeshComp));
+		const UMirrorDataTable* MirrorTable = EventReference.GetMirrorDataTable();
+
+		const TPair<FGuid, FObjectKey> StreamKey(Guid, MirrorTable);
+		int32 StreamIndex;
+		if (const int32* ExistingIndex = StreamIndices.Find(StreamKey))
+		{
+			StreamIndex = *ExistingIndex;
+		}
+		else
+		{
+			FCapturedNotifyStream& Stream = Streams.AddDefaulted_GetRef();
+			Stream.Guid = Guid;
+			Stream.Notify = FSoftObjectPath(Notify);
+			Stream.SpawnableClass = const_cast<UAnimNotifyState_SpawnActorBase*>(Notify)->GetSpawnableClassToLoad().ToSoftObjectPath();
+			Stream.MirrorTable = FSoftObjectPath(MirrorTable);
+			Stream.ComponentKey = ComponentKeys.FindOrAdd(MeshComp, ComponentKeys.Num());
+			StreamIndex = StreamIndices.Add(StreamKey, Streams.Num() - 1);
+		}
+		Events.Add({Type, StreamIndex, Value});
+	}
+
+	bool FNotifyCapture::Save(const FString& FilePath) const
+	{
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+
+		uint32 Magic = NotifyCapture::Magic;
+		int32 Version = NotifyCapture::Version;
+		Writer << Magic << Version;
+
+		int32 NumStreams = Streams.Num();
+		Writer.SerializeIntPacked(reinterpret_cast<uint32&>(NumStreams));
+		for (const FCapturedNotifyStream& ConstStream : Streams)
+		{
+			FCapturedNotifyStream Stream = ConstStream;
+			FString NotifyPath = Stream.Notify.ToString();
+			FString ClassPath = Stream.SpawnableClass.ToString();
+			FString MirrorTablePath = Stream.MirrorTable.ToString();
+			Writer << Stream.Guid << NotifyPath << ClassPath << MirrorTablePath;
+			Writer.SerializeIntPacked(reinterpret_cast<uint32&>(Stream.ComponentKey));
+		}
+
+		int32 NumEvents = Events.Num();
+		Writer.SerializeIntPacked(reinterpret_cast<uint32&>(NumEvents));
+		for (const FCapturedNotifyEvent& ConstEvent : Events)
+		{
+			FCapturedNotifyEvent Event = ConstEvent;
+			uint8 Type = static_cast<uint8>(Event.Type);
+			Writer << Type;
+			if (Event.Type != ENotifyCaptureEvent::Frame)
+			{
+				Writer.SerializeIntPacked(reinterpret_cast<uint32&>(Event.StreamIndex));
+			}
+			if (Event.Type != ENotifyCaptureEvent::End)
+			{
+				Writer << Event.Value;
+			}
+		}
+
+		return FFileHelper::SaveArrayToFile(Data, *FilePath);
+	}
+
+	bool FNotifyCapture::Load(const FString& FilePath)
+	{
+		Reset();
+
+		TArray<uint8> Data;
+		if (!FFileHelper::LoadFileToArray(Data, *FilePath))
+		{
+			return false;
+		}
+		FMemoryReader Reader(Data);
+
+		uint32 Magic = 0;
+		int32 Version = 0;
+		Reader << Magic << Version;
+		if (Magic != NotifyCapture::Magic || Version != NotifyCapture::Version)
+		{
+			UE_LOG(LogAnimActorSys, Error, TEXT("%s is not a notify capture of version %d."), *FilePath, NotifyCapture::Version)
+			return false;
+		}
+
+		uint32 NumStreams = 0;
+		Reader.SerializeIntPacked(NumStreams);
+		for (uint32 StreamIndex = 0; StreamIndex < NumStreams && !Reader.IsError(); ++StreamIndex)
+		{
+			FCapturedNotifyStream& Stream = Streams.AddDefaulted_GetRef();
+			FString NotifyPath, ClassPath, MirrorTablePath;
+			Reader << Stream.Guid << NotifyPath << ClassPath << MirrorTablePath;
+			Reader.SerializeIntPacked(reinterpret_cast<uint32&>(Stream.ComponentKey));
+			Stream.Notify = FSoftObjectPath(NotifyPath);
+			Stream.SpawnableClass = FSoftObjectPath(ClassPath);
+			Stream.MirrorTable = FSoftObjectPath(MirrorTablePath);
+		}
+
+		uint32 NumEvents = 0;
+		Reader.SerializeIntPacked(NumEvents);
+		Events.Reserve(NumEvents);
+		for (uint32 EventIndex = 0; EventIndex < NumEvents && !Reader.IsError(); ++EventIndex)
+		{
+			FCapturedNotifyEvent& Event = Events.AddDefaulted_GetRef();
+			uint8 Type = 0;
+			Reader << Type;
+			Event.Type = static_cast<ENotifyCaptureEvent>(Type);
+			if (Event.Type != ENotifyCaptureEvent::Frame)
+			{
+				Reader.SerializeIntPacked(reinterpret_cast<uint32&>(Event.StreamIndex));
+			}
+			if (Event.Type != ENotifyCaptureEvent::End)
+			{
+				Reader << Event.Value;
+			}
+		}
+
+		if (Reader.IsError())
+		{
+			UE_LOG(LogAnimActorSys, Error, TEXT("Notify capture %s is truncated."), *FilePath)
+			Reset();
+			return false;
+		}
+		return true;
+	}
+
+	void FNotifyCapture::Reset()
+	{
+		Streams.Reset();
+		Events.Reset();
+		StreamIndices.Reset();
+		ComponentKeys.Reset();
+	}
+}
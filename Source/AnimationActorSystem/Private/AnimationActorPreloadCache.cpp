@@ -0,0 +1,102 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorPreloadCache.h"
+
+#include "AnimationActorSystem.h"
+#include "AnimationActorSystemSettings.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace AnimActorSys
+{
+	void FPreloadCache::Load(const FString& MapPackageName)
+	{
+		Entries.Reset();
+		CacheFilePath = FPaths::ProjectSavedDir() / TEXT("AnimationActorSystem") / TEXT("PreloadCache")
+			/ FPaths::MakeValidFileName(MapPackageName.Replace(TEXT("/"), TEXT("_")), TEXT('_')) + TEXT(".txt");
+
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *CacheFilePath))
+		{
+			return;
+		}
+
+		// One entry per line: <Path>\t<LoadTimeMs>\t<UnusedSessions>
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Columns;
+			if (Line.ParseIntoArray(Columns, TEXT("\t")) != 3)
+			{
+				continue;
+			}
+			FEntry& Entry = Entries.Add(FSoftObjectPath(Columns[0]));
+			LexFromString(Entry.LoadTimeMs, *Columns[1]);
+			LexFromString(Entry.UnusedSessions, *Columns[2]);
+		}
+		UE_LOG(LogAnimActorSys, Verbose, TEXT("Loaded %d preload cache entries from %s"), Entries.Num(), *CacheFilePath)
+	}
+
+	void FPreloadCache::Save()
+	{
+		if (!IsLoaded())
+		{
+			return;
+		}
+
+		const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			FEntry& Entry = It->Value;
+			Entry.UnusedSessions = Entry.bSyncLoadedThisSession || Entry.bUsedThisSession ? 0 : Entry.UnusedSessions + 1;
+			if (Entry.UnusedSessions > Settings->PreloadCacheMaxUnusedSessions)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		TArray<FString> Lines;
+		for (const FSoftObjectPath& Path : GetPathsToPreload())
+		{
+			const FEntry& Entry = Entries[Path];
+			Lines.Add(FString::Printf(TEXT("%s\t%.3f\t%d"), *Path.ToString(), Entry.LoadTimeMs, Entry.UnusedSessions));
+		}
+		FFileHelper::SaveStringArrayToFile(Lines, *CacheFilePath);
+	}
+
+	void FPreloadCache::RecordSyncLoad(const FSoftObjectPath& Path, float LoadTimeMs)
+	{
+		if (!IsLoaded() || LoadTimeMs < UAnimationActorSystemSettings::Get()->PreloadCacheMinLoadTimeMs)
+		{
+			return;
+		}
+		FEntry& Entry = Entries.FindOrAdd(Path);
+		Entry.LoadTimeMs = LoadTimeMs;
+		Entry.bSyncLoadedThisSession = true;
+	}
+
+	void FPreloadCache::MarkUsed(const FSoftObjectPath& Path)
+	{
+		if (FEntry* Entry = Entries.Find(Path))
+		{
+			Entry->bUsedThisSession = true;
+		}
+	}
+
+	TArray<FSoftObjectPath> FPreloadCache::GetPathsToPreload() const
+	{
+		TArray<FSoftObjectPath> Paths;
+		Entries.GenerateKeyArray(Paths);
+		Paths.Sort([this](const FSoftObjectPath& A, const FSoftObjectPath& B)
+		{
+			return Entries[A].LoadTimeMs > Entries[B].LoadTimeMs;
+		});
+
+		const int32 MaxEntries = UAnimationActorSystemSettings::Get()->PreloadCacheMaxEntries;
+		if (Paths.Num() > MaxEntries)
+		{
+			Paths.SetNum(MaxEntries);
+		}
+		return Paths;
+	}
+}
@@ -0,0 +1,21 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorSkeletalMeshActor.h"
+
+#include "AnimationActorSkeletalMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+
+AAnimationActorSkeletalMeshActor::AAnimationActorSkeletalMeshActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UAnimationActorSkeletalMeshComponent>(TEXT("SkeletalMeshComponent0")))
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetCanBeDamaged(false);
+
+	USkeletalMeshComponent* Comp = GetSkeletalMeshComponent();
+	// The notifies make it movable anyway, doing it here saves changing the mobility of every spawn.
+	Comp->SetMobility(EComponentMobility::Movable);
+	Comp->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	Comp->SetGenerateOverlapEvents(false);
+	Comp->KinematicBonesUpdateToPhysics = EKinematicBonesUpdateToPhysics::SkipAllBones;
+}
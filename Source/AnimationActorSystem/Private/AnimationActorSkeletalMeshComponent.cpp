@@ -0,0 +1,108 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorSkeletalMeshComponent.h"
+
+#include "AnimationActorSystemSettings.h"
+
+void UAnimationActorSkeletalMeshComponent::SetUpdateRateSource(USkeletalMeshComponent* Source)
+{
+	if (USkeletalMeshComponent* PreviousSource = UpdateRateSource.Get(); PreviousSource && PreviousSource != Source)
+	{
+		RemoveTickPrerequisiteComponent(PreviousSource);
+	}
+	UpdateRateSource = Source;
+	StopInheritingUpdateRate();
+	SetForcedLOD(SignificanceLOD);
+
+	// The source has to update first, so we know whether it skipped this frame.
+	if (Source)
+	{
+		AddTickPrerequisiteComponent(Source);
+	}
+}
+
+void UAnimationActorSkeletalMeshComponent::SetSignificanceLOD(const int32 ForcedLOD)
+{
+	SignificanceLOD = ForcedLOD;
+	SetForcedLOD(ForcedLOD);
+}
+
+void UAnimationActorSkeletalMeshComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+                                                         FActorComponentTickFunction* ThisTickFunction)
+{
+	if (const USkeletalMeshComponent* Source = UpdateRateSource.Get())
+	{
+		const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+		if (Settings->bInheritOwnerUpdateRate)
+		{
+			InheritUpdateRate(*Source, DeltaTime);
+		}
+		else
+		{
+			StopInheritingUpdateRate();
+		}
+		if (Settings->bFollowOwnerLOD)
+		{
+			FollowLOD(*Source);
+		}
+	}
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+void UAnimationActorSkeletalMeshComponent::InheritUpdateRate(const USkeletalMeshComponent& Source, const float DeltaTime)
+{
+	const FAnimUpdateRateParameters* SourceParams = Source.ShouldUseUpdateRateOptimizations() ? Source.AnimUpdateRateParams : nullptr;
+	if (!SourceParams)
+	{
+		// The source updates every frame again, so must we.
+		StopInheritingUpdateRate();
+		return;
+	}
+
+	if (!bInheritingUpdateRate)
+	{
+		// Interpolating skipped frames needs update rate parameters of our own.
+		bEnableUpdateRateOptimizations = true;
+		bInheritingUpdateRate = true;
+	}
+	EnableExternalTickRateControl(true);
+	SetExternalTickRate(static_cast<uint8>(FMath::Clamp(SourceParams->UpdateRate, 1, MAX_uint8)));
+
+	SkippedTime += DeltaTime;
+	const bool bUpdate = !SourceParams->ShouldSkipUpdate();
+	EnableExternalUpdate(bUpdate);
+	if (bUpdate)
+	{
+		SetExternalDeltaTime(SkippedTime);
+		SkippedTime = 0.f;
+	}
+	EnableExternalInterpolation(SourceParams->ShouldInterpolateSkippedFrames());
+	SetExternalInterpolationAlpha(SourceParams->GetInterpolationAlpha());
+}
+
+void UAnimationActorSkeletalMeshComponent::StopInheritingUpdateRate()
+{
+	SkippedTime = 0.f;
+	if (!bInheritingUpdateRate)
+	{
+		return;
+	}
+	bInheritingUpdateRate = false;
+	
+	EnableExternalTickRateControl(false);
+	EnableExternalUpdate(false);
+	EnableExternalInterpolation(false);
+	SetExternalInterpolationAlpha(0.f);
+	bEnableUpdateRateOptimizations = GetDefault<UAnimationActorSkeletalMeshComponent>()->bEnableUpdateRateOptimizations;
+}
+
+void UAnimationActorSkeletalMeshComponent::FollowLOD(const USkeletalMeshComponent& Source)
+{
+	// Forced LODs are 1 based, 0 means not forced. The coarser of the source's LOD and the one of our significance wins.
+	const int32 ForcedLOD = FMath::Max(FMath::Min(Source.GetPredictedLODLevel(), GetNumLODs() - 1) + 1, SignificanceLOD);
+	if (GetForcedLOD() != ForcedLOD)
+	{
+		SetForcedLOD(ForcedLOD);
+	}
+}
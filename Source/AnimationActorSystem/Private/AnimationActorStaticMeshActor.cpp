@@ -0,0 +1,20 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorStaticMeshActor.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+
+AAnimationActorStaticMeshActor::AAnimationActorStaticMeshActor(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetCanBeDamaged(false);
+
+	UStaticMeshComponent* Comp = GetStaticMeshComponent();
+	// The notifies make it movable anyway, doing it here saves changing the mobility of every spawn.
+	Comp->SetMobility(EComponentMobility::Movable);
+	Comp->SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+	Comp->SetGenerateOverlapEvents(false);
+}
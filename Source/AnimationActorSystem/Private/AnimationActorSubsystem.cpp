@@ -3,85 +3,2078 @@
 
 #include "AnimationActorSubsystem.h"
 
+#include "AnimationActorAnimInstance.h"
+#include "AnimationActorPoolable.h"
+#include "AnimationActorSkeletalMeshComponent.h"
+#include "AnimNotifyState_SpawnActorBase.h"
 #include "AnimationActorSystem.h"
 #include "AnimationActorSystemSettings.h"
+#include "AnimationActorSystemStats.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/SkeletalMeshActor.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Engine/AssetManager.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/StreamableManager.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
 
 FName UAnimationActorSubsystem::SpawnedAnimActorTag = FName(TEXT("AnimActor"));
+FName UAnimationActorSubsystem::SpawnDependenciesAssetRegistryTag = FName(TEXT("AnimActorSpawnDependencies"));
+FName UAnimationActorSubsystem::SpawnFallbackDependenciesAssetRegistryTag = FName(TEXT("AnimActorSpawnFallbackDependencies"));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice CmdAnimActorSysMemReport(
+	TEXT("AnimActorSys.MemReport"),
+	TEXT("Lists the AnimActors, pools and referenced classes and assets of the current world with their estimated sizes.\n")
+	TEXT("Sort=Total|Cpu|Gpu|Count|Age|Name sorts the rows (Total by default). Csv[=File] additionally writes them to a CSV file."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+	{
+		const UAnimationActorSubsystem* Subsystem = World ? World->GetSubsystem<UAnimationActorSubsystem>() : nullptr;
+		if (!Subsystem)
+		{
+			Ar.Log(TEXT("No AnimationActorSubsystem in this world."));
+			return;
+		}
+
+		AnimActorSys::EMemoryReportSortBy SortBy = AnimActorSys::EMemoryReportSortBy::TotalBytes;
+		bool bWriteCsv = false;
+		FString CsvPath;
+		for (const FString& Arg : Args)
+		{
+			FString Value;
+			if (FParse::Value(*Arg, TEXT("Sort="), Value) && !AnimActorSys::FMemoryReport::ParseSortBy(Value, SortBy))
+			{
+				Ar.Logf(TEXT("Unknown sort order %s."), *Value);
+			}
+			else if (Arg.StartsWith(TEXT("Csv"), ESearchCase::IgnoreCase))
+			{
+				bWriteCsv = true;
+				FParse::Value(*Arg, TEXT("Csv="), CsvPath);
+			}
+		}
+
+		AnimActorSys::FMemoryReport Report;
+		Subsystem->GatherMemoryReport(Report);
+		Report.Sort(SortBy);
+		Report.Log(Ar);
+
+		if (bWriteCsv)
+		{
+			if (CsvPath.IsEmpty())
+			{
+				CsvPath = FPaths::ProjectSavedDir() / TEXT("AnimationActorSystem") / TEXT("MemReports")
+					/ FPaths::MakeValidFileName(Report.World.Replace(TEXT("/"), TEXT("_")), TEXT('_'))
+					+ TEXT("_") + FDateTime::Now().ToString() + TEXT(".csv");
+			}
+			Ar.Logf(Report.SaveCsv(CsvPath) ? TEXT("Wrote %s.") : TEXT("Failed to write %s."), *CsvPath);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAnimActorSysCaptureStart(
+	TEXT("AnimActorSys.Capture.Start"),
+	TEXT("Starts recording the spawn notify events of the current world."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UAnimationActorSubsystem* Subsystem = World ? World->GetSubsystem<UAnimationActorSubsystem>() : nullptr)
+		{
+			Subsystem->StartNotifyCapture();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs CmdAnimActorSysCaptureStop(
+	TEXT("AnimActorSys.Capture.Stop"),
+	TEXT("Stops recording the spawn notify events and saves them. Optionally takes the file to write to."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UAnimationActorSubsystem* Subsystem = World ? World->GetSubsystem<UAnimationActorSubsystem>() : nullptr)
+		{
+			Subsystem->StopNotifyCapture(Args.IsEmpty() ? FString() : Args[0]);
+		}
+	}));
+
+void UAnimationActorSubsystem::GetAnimationSpawnDependencies(const FSoftObjectPath& Animation,
+                                                             TArray<FSoftObjectPath>& OutDependencies)
+{
+	const FAssetData AssetData = IAssetRegistry::GetChecked().GetAssetByObjectPath(Animation);
+	if (!AssetData.IsValid())
+	{
+		return;
+	}
+	
+	// Animations saved before the fallback tag existed only have the regular one.
+	FString DependencyString;
+	const bool bFoundFallback = UAnimationActorSystemSettings::Get()->ShouldUseSkeletalMeshFallback()
+		&& AssetData.GetTagValue(SpawnFallbackDependenciesAssetRegistryTag, DependencyString);
+	if (!bFoundFallback && !AssetData.GetTagValue(SpawnDependenciesAssetRegistryTag, DependencyString))
+	{
+		return;
+	}
+
+	TArray<FString> DependencyStrings;
+	DependencyString.ParseIntoArray(DependencyStrings, TEXT(";"));
+	for (const FString& Dependency : DependencyStrings)
+	{
+		OutDependencies.AddUnique(FSoftObjectPath(Dependency));
+	}
+}
+
+TSharedPtr<FStreamableHandle> UAnimationActorSubsystem::PreloadAnimationDependencies(
+	TConstArrayView<TSoftObjectPtr<UAnimSequenceBase>> Animations, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> Dependencies;
+	for (const TSoftObjectPtr<UAnimSequenceBase>& Animation : Animations)
+	{
+		GetAnimationSpawnDependencies(Animation.ToSoftObjectPath(), Dependencies);
+	}
+	if (Dependencies.IsEmpty())
+	{
+		return nullptr;
+	}
+
+	UE_LOG(LogAnimActorSys, Verbose, TEXT("Preloading %d spawn dependencies of %d animations."), Dependencies.Num(), Animations.Num())
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Dependencies), MoveTemp(OnLoaded));
+}
 
 AActor* UAnimationActorSubsystem::SpawnAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform,
-                                                 const FGuid Guid)
-{	
+                                                 const FGuid Guid, const TFunction<void(AActor*)>& PreSpawnInitialization)
+{
+	ANIMACTORSYS_SCOPE(SpawnAnimActor, Guid);
+	
 	if (GIsCookerLoadingPackage || IsRunningCookCommandlet())
 	{
-		UE_LOG(LogAnimActorSys, Display, TEXT("Tried to spawn actor during cook. Skipping."))
-		return nullptr;
+		UE_LOG(LogAnimActorSys, Display, TEXT("Tried to spawn actor during cook. Skipping."))
+		return nullptr;
+	}
+	
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	MarkClassReferenced(Class);
+
+	UWorld* World = GetWorld();
+	checkf(World, TEXT("WorldSubsystems should not be able to exist without world."));
+
+	if(World->bIsTearingDown)
+	{
+		return nullptr;
+	}
+	
+	if(AnimActorSys::FAnimActorSlot* FoundSlot = Registry.Resolve(Registry.Find(Guid)))
+	{
+		if(AActor* Actor = FoundSlot->Counter.Increment())
+		{
+			return Actor;
+		}
+		Registry.Remove(Registry.Find(Guid));
+	}
+	
+	AActor* SpawnedActor = TakePreSpawnedActor(Guid, Class, Transform);
+	if (!SpawnedActor)
+	{
+		SpawnedActor = AcquireFromPool(Class, Transform);
+		RecordPoolAccess(SpawnedActor != nullptr);
+	}
+	if (SpawnedActor)
+	{
+		// Reused actors are registered already, so they can only be configured afterward.
+		if (PreSpawnInitialization)
+		{
+			PreSpawnInitialization(SpawnedActor);
+		}
+	}
+	else
+	{
+		SpawnedActor = SpawnNewAnimActor(Class, Transform, PreSpawnInitialization);
+	}
+	if (SpawnedActor)
+	{
+		ApplyTickInterval(SpawnedActor, nullptr, UAnimationActorSystemSettings::Get()->GetAnimActorTickInterval());
+		Registry.Resolve(Registry.Add(Guid, SpawnedActor))->Counter.Increment();
+	}
+	return SpawnedActor;
+}
+
+void UAnimationActorSubsystem::RequestAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform,
+                                                const FGuid Guid, int32 Priority,
+                                                TFunction<void(AActor*)>&& OnSpawned,
+                                                TFunction<void(AActor*)>&& PreSpawnInitialization)
+{
+	if (!Class)
+	{
+		return;
+	}
+	
+	// Already spawned: just another user of the same actor.
+	if (const AnimActorSys::FAnimActorSlot* FoundSlot = Registry.Resolve(Registry.Find(Guid));
+		FoundSlot && FoundSlot->Counter.GetActor())
+	{
+		if (AActor* Actor = SpawnAnimActor(Class, Transform, Guid); Actor && OnSpawned)
+		{
+			OnSpawned(Actor);
+		}
+		return;
+	}
+
+	// Already queued: the pending request now has another user to cancel before it is dropped.
+	if (AnimActorSys::FPendingSpawnRequest* Pending = PendingSpawns.FindByPredicate(
+		[&Guid](const AnimActorSys::FPendingSpawnRequest& Request) { return Request.Guid == Guid; }))
+	{
+		Pending->Count++;
+		return;
+	}
+
+	AnimActorSys::FPendingSpawnRequest Request;
+	Request.Guid = Guid;
+	Request.Class = Class;
+	Request.Transform = Transform;
+	Request.Priority = Priority;
+	Request.OnSpawned = MoveTemp(OnSpawned);
+	Request.PreSpawnInitialization = MoveTemp(PreSpawnInitialization);
+	
+	// Revealing an actor the lookahead already prepared is cheap enough to not wait for budget.
+	// Entries that are still streaming or waiting to pre-spawn would need a full spawn, so they don't count.
+	const AnimActorSys::FLookaheadEntry* LookaheadEntry = LookaheadEntries.Find(Guid);
+	const AActor* PreSpawnedActor = LookaheadEntry ? LookaheadEntry->PreSpawnedActor.Get() : nullptr;
+	if (HasFrameBudgetLeft() || (IsValid(PreSpawnedActor) && PreSpawnedActor->GetClass() == Class))
+	{
+		ExecuteSpawnRequest(Request);
+		return;
+	}
+
+	MarkClassReferenced(Class);
+	
+	// Insert before requests of the same priority, so those that have waited longer are processed first.
+	const int32 InsertIndex = Algo::LowerBoundBy(PendingSpawns, Priority, &AnimActorSys::FPendingSpawnRequest::Priority);
+	PendingSpawns.Insert(MoveTemp(Request), InsertIndex);
+}
+
+void UAnimationActorSubsystem::EnqueueSpawnRequest(const TSubclassOf<AActor>& Class, const FTransform& Transform,
+                                                   const FGuid& Guid, const int32 Priority, TFunction<void(AActor*)>&& OnSpawned)
+{
+	AnimActorSys::FAsyncAnimActorRequest Request;
+	Request.Type = AnimActorSys::EAsyncAnimActorRequestType::Spawn;
+	Request.Guid = Guid;
+	Request.Class = Class.Get();
+	Request.Transform = Transform;
+	Request.Priority = Priority;
+	Request.OnSpawned = MoveTemp(OnSpawned);
+	AsyncRequests.Enqueue(MoveTemp(Request));
+}
+
+void UAnimationActorSubsystem::EnqueueDestroyRequest(const FGuid& Guid)
+{
+	AnimActorSys::FAsyncAnimActorRequest Request;
+	Request.Type = AnimActorSys::EAsyncAnimActorRequestType::Destroy;
+	Request.Guid = Guid;
+	AsyncRequests.Enqueue(MoveTemp(Request));
+}
+
+void UAnimationActorSubsystem::EnqueueTransformUpdate(const FGuid& Guid, const FTransform& RelativeTransform)
+{
+	AnimActorSys::FAsyncAnimActorRequest Request;
+	Request.Type = AnimActorSys::EAsyncAnimActorRequestType::SetTransform;
+	Request.Guid = Guid;
+	Request.Transform = RelativeTransform;
+	AsyncRequests.Enqueue(MoveTemp(Request));
+}
+
+void UAnimationActorSubsystem::ProcessAsyncRequests()
+{
+	check(IsInGameThread());
+
+	AnimActorSys::FAsyncAnimActorRequest Request;
+	while (AsyncRequests.Dequeue(Request))
+	{
+		switch (Request.Type)
+		{
+			case AnimActorSys::EAsyncAnimActorRequestType::Spawn:
+				// Async requests are subject to the same concurrency caps as notifies. A refused or unloaded request still expects its destroy request.
+				if (UClass* Class = Request.Class.Get(); Class && AdmitAnimActor(Request.Guid, Class, nullptr, Request.Priority, nullptr))
+				{
+					RequestAnimActor(Class, Request.Transform, Request.Guid, Request.Priority, MoveTemp(Request.OnSpawned));
+				}
+				else
+				{
+					SkipAnimActor(Request.Guid);
+				}
+				break;
+			case AnimActorSys::EAsyncAnimActorRequestType::Destroy:
+				DestroyAnimActor(Request.Guid);
+				break;
+			case AnimActorSys::EAsyncAnimActorRequestType::SetTransform:
+				if (USceneComponent* Component = GetAnimComponentByGuid(Request.Guid))
+				{
+					Component->SetRelativeTransform(Request.Transform);
+				}
+				else if (AnimActorSys::FPendingSpawnRequest* PendingSpawn = PendingSpawns.FindByPredicate(
+					[&Request](const AnimActorSys::FPendingSpawnRequest& Pending) { return Pending.Guid == Request.Guid; }))
+				{
+					PendingSpawn->Transform = Request.Transform;
+				}
+				break;
+		}
+	}
+}
+
+void UAnimationActorSubsystem::ExecuteSpawnRequest(AnimActorSys::FPendingSpawnRequest& Request)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	
+	AActor* SpawnedActor = SpawnAnimActor(Request.Class, Request.Transform, Request.Guid, Request.PreSpawnInitialization);
+	if (AnimActorSys::FAnimActorSlot* Slot = SpawnedActor ? Registry.Resolve(Registry.Find(Request.Guid)) : nullptr)
+	{
+		// Every NotifyBegin that got collapsed into this request expects its own NotifyEnd to be counted.
+		for (int32 AdditionalUser = 1; AdditionalUser < Request.Count; ++AdditionalUser)
+		{
+			Slot->Counter.Increment();
+		}
+	}
+	if (SpawnedActor && Request.OnSpawned)
+	{
+		Request.OnSpawned(SpawnedActor);
+	}
+
+	FrameBudgetSpentSeconds += FPlatformTime::Seconds() - StartTime;
+	FrameBudgetOperationCount++;
+}
+
+bool UAnimationActorSubsystem::HasFrameBudgetLeft()
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	
+	// Worlds that don't tick (e.g. animation editor previews) would never get around to process queued requests.
+	if (!Settings->bUseFrameBudget || !GetWorld()->IsGameWorld())
+	{
+		return true;
+	}
+	if (FrameBudgetFrame != GFrameCounter)
+	{
+		FrameBudgetFrame = GFrameCounter;
+		FrameBudgetSpentSeconds = 0.0;
+		FrameBudgetOperationCount = 0;
+	}
+	return FrameBudgetOperationCount < Settings->MinOperationsPerFrame
+		|| FrameBudgetSpentSeconds * 1000.0 < Settings->FrameBudgetMs;
+}
+
+void UAnimationActorSubsystem::ProcessQueuedRequests()
+{
+	// Spawns first, since released actors are already hidden and are only waiting to be cleaned up.
+	while (!PendingSpawns.IsEmpty() && HasFrameBudgetLeft())
+	{
+		AnimActorSys::FPendingSpawnRequest Request = PendingSpawns.Pop(EAllowShrinking::No);
+		ExecuteSpawnRequest(Request);
+	}
+
+	while (!PendingReleases.IsEmpty() && HasFrameBudgetLeft())
+	{
+		if (AActor* Actor = PendingReleases.Pop(EAllowShrinking::No).Get(); IsValid(Actor))
+		{
+			ReleaseOrDestroy(Actor);
+		}
+	}
+}
+
+void UAnimationActorSubsystem::ReleaseOrDestroy(AActor* Actor)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	if (!ReleaseToPool(Actor))
+	{
+		Actor->Destroy();
+	}
+	FrameBudgetSpentSeconds += FPlatformTime::Seconds() - StartTime;
+	FrameBudgetOperationCount++;
+}
+
+void UAnimationActorSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_AnimActorSys_Tick);
+	CSV_SCOPED_TIMING_STAT(AnimActorSys, Tick);
+	
+	ApplyScalabilityChanges();
+	ProcessAsyncRequests();
+	
+	// Tick runs after the notifies of this frame, so whatever they spent already counts towards the budget.
+	ProcessQueuedRequests();
+	UpdateLookahead();
+	ProcessLookaheadEntries();
+	UpdateSignificance();
+	UpdateInstanceTransforms();
+	UpdateSharedPoseGroups();
+	UpdateReferenceRelease();
+	UpdateStats();
+}
+
+void UAnimationActorSubsystem::RecordPoolAccess(const bool bHit)
+{
+	if (bHit)
+	{
+		PoolHitCount++;
+		INC_DWORD_STAT(STAT_AnimActorSys_PoolHits);
+	}
+	else
+	{
+		PoolMissCount++;
+		INC_DWORD_STAT(STAT_AnimActorSys_PoolMisses);
+	}
+}
+
+void UAnimationActorSubsystem::UpdateStats() const
+{
+	const float PoolHitRate = PoolHitCount + PoolMissCount > 0
+		? 100.f * static_cast<float>(PoolHitCount) / static_cast<float>(PoolHitCount + PoolMissCount) : 0.f;
+	SET_DWORD_STAT(STAT_AnimActorSys_LiveAnimActors, Registry.Num());
+	SET_FLOAT_STAT(STAT_AnimActorSys_PoolHitRate, PoolHitRate);
+	CSV_CUSTOM_STAT(AnimActorSys, LiveAnimActors, Registry.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(AnimActorSys, PoolHitRate, PoolHitRate, ECsvCustomStatOp::Set);
+
+	if (!AnimActorSys::ShouldReportLiveCounts())
+	{
+		return;
+	}
+	
+	TMap<FName, int32, TInlineSetAllocator<16>> LiveCountsPerClass;
+	Registry.ForEach([&LiveCountsPerClass](AnimActorSys::FAnimActorHandle, const AnimActorSys::FAnimActorSlot& Slot)
+	{
+		static const FName InstanceName = FName(TEXT("InstancedStaticMesh"));
+		const UObject* LiveObject = Slot.Component.IsValid() ? static_cast<const UObject*>(Slot.Component.Get()) : Slot.Counter.GetActor();
+		LiveCountsPerClass.FindOrAdd(LiveObject ? LiveObject->GetClass()->GetFName() : InstanceName)++;
+	});
+	for (const auto& [ClassName, Count] : LiveCountsPerClass)
+	{
+#if CSV_PROFILER
+		FCsvProfiler::RecordCustomStat(ClassName, CSV_CATEGORY_INDEX(AnimActorSys), Count, ECsvCustomStatOp::Set);
+#endif
+		AnimActorSys::TraceLiveCount(ClassName, Count);
+	}
+}
+
+EAnimActorSignificance UAnimationActorSubsystem::EvaluateSignificance(const USkeletalMeshComponent* Owner) const
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const UWorld* World = GetWorld();
+	if (!Settings->bEnableSignificance || !Owner || !World->IsGameWorld())
+	{
+		return EAnimActorSignificance::Full;
+	}
+
+	float ClosestFOV = 90.f;
+	const double ClosestDistanceSquared = GetDistanceSquaredToClosestViewer(Owner->Bounds.Origin, &ClosestFOV);
+	
+	// Without anybody looking, there is nothing to base the decision on.
+	if (ClosestDistanceSquared == TNumericLimits<double>::Max())
+	{
+		return EAnimActorSignificance::Full;
+	}
+
+	const double Distance = FMath::Sqrt(ClosestDistanceSquared);
+	if (Distance > Settings->SkipSignificanceDistance)
+	{
+		return EAnimActorSignificance::Skip;
+	}
+	if (Distance > Settings->ReducedSignificanceDistance || !Owner->WasRecentlyRendered(Settings->SignificanceRenderTimeTolerance))
+	{
+		return EAnimActorSignificance::Reduced;
+	}
+	
+	// Fraction of the screen height covered by the bounds, same as the LOD screen sizes.
+	const double HalfViewHeight = Distance * FMath::Tan(FMath::DegreesToRadians(ClosestFOV * 0.5));
+	const double ScreenSize = Owner->Bounds.SphereRadius / FMath::Max(HalfViewHeight, UE_KINDA_SMALL_NUMBER);
+	return ScreenSize < Settings->ReducedSignificanceScreenSize ? EAnimActorSignificance::Reduced : EAnimActorSignificance::Full;
+}
+
+double UAnimationActorSubsystem::GetDistanceSquaredToClosestViewer(const FVector& Location, float* OutFOV) const
+{
+	double ClosestDistanceSquared = TNumericLimits<double>::Max();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController)
+		{
+			continue;
+		}
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		const double DistanceSquared = FVector::DistSquared(ViewLocation, Location);
+		if (DistanceSquared < ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			if (OutFOV && PlayerController->PlayerCameraManager)
+			{
+				*OutFOV = PlayerController->PlayerCameraManager->GetFOVAngle();
+			}
+		}
+	}
+	return ClosestDistanceSquared;
+}
+
+bool UAnimationActorSubsystem::AdmitAnimActor(const FGuid& Guid, const UClass* Class, const UObject* Asset,
+                                              const int32 Priority, const USceneComponent* Owner)
+{
+	// Another notify for an already admitted Guid shares its AnimActor, so it doesn't take up more of the caps.
+	if (AnimActorSys::FAnimActorAdmission* Existing = Admissions.Find(Guid))
+	{
+		Existing->Users++;
+		return true;
+	}
+	
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const int32* ClassCap = Class ? Settings->MaxLiveAnimActorsPerClass.Find(TSoftClassPtr<AActor>(Class)) : nullptr;
+	const int32* AssetCap = Asset ? Settings->MaxLiveAnimActorsPerMesh.Find(TSoftObjectPtr<UObject>(Asset)) : nullptr;
+	
+	const TObjectKey<UClass> ClassKey(Class);
+	const TObjectKey<UObject> AssetKey(Asset);
+	
+	// Global, per class and per mesh. A victim has to be inside the scope whose cap is reached.
+	const int32 Caps[] = {Settings->GetMaxLiveAnimActors(), ClassCap ? *ClassCap : 0, AssetCap ? *AssetCap : 0};
+	TOptional<double> DistanceSquared;
+	for (int32 ScopeIndex = 0; ScopeIndex < static_cast<int32>(UE_ARRAY_COUNT(Caps)); ++ScopeIndex)
+	{
+		const int32 Cap = Caps[ScopeIndex];
+		if (Cap <= 0)
+		{
+			continue;
+		}
+		auto IsInScope = [ScopeIndex, &ClassKey, &AssetKey](const AnimActorSys::FAnimActorAdmission& Admission)
+		{
+			return ScopeIndex == 0
+				|| (ScopeIndex == 1 && Admission.Class == ClassKey)
+				|| (ScopeIndex == 2 && Admission.Asset == AssetKey);
+		};
+		// Counted on admission and release, so the admissions only have to be searched once a cap is reached.
+		auto GetCount = [this, ScopeIndex, &ClassKey, &AssetKey]
+		{
+			return ScopeIndex == 0 ? Admissions.Num()
+				: ScopeIndex == 1 ? AdmissionsPerClass.FindRef(ClassKey)
+				: AdmissionsPerAsset.FindRef(AssetKey);
+		};
+		
+		while (GetCount() >= Cap)
+		{
+			if (Settings->ConcurrencyPolicy != EAnimActorConcurrencyPolicy::EvictLowestPriority)
+			{
+				UE_LOG(LogAnimActorSys, Verbose, TEXT("Refused AnimActor for Guid %s, concurrency cap of %d reached."), *Guid.ToString(), Cap)
+				return false;
+			}
+			
+			// Lowest priority first, then farthest. The Guid breaks remaining ties, so the choice doesn't depend on map order.
+			const FGuid* Victim = nullptr;
+			int32 VictimPriority = 0;
+			double VictimDistanceSquared = 0.0;
+			for (const auto& [AdmittedGuid, Admission] : Admissions)
+			{
+				if (!IsInScope(Admission) || (Victim && Admission.Priority > VictimPriority))
+				{
+					continue;
+				}
+				const USceneComponent* AdmittedOwner = Admission.Owner.Get();
+				const double AdmittedDistanceSquared = AdmittedOwner
+					? GetDistanceSquaredToClosestViewer(AdmittedOwner->GetComponentLocation()) : 0.0;
+				const bool bIsLessImportant = !Victim
+					|| Admission.Priority < VictimPriority
+					|| AdmittedDistanceSquared > VictimDistanceSquared
+					|| (AdmittedDistanceSquared == VictimDistanceSquared && AdmittedGuid < *Victim);
+				if (bIsLessImportant)
+				{
+					Victim = &AdmittedGuid;
+					VictimPriority = Admission.Priority;
+					VictimDistanceSquared = AdmittedDistanceSquared;
+				}
+			}
+			
+			if (!DistanceSquared.IsSet())
+			{
+				DistanceSquared = Owner ? GetDistanceSquaredToClosestViewer(Owner->GetComponentLocation()) : 0.0;
+			}
+			const bool bMayEvict = Victim
+				&& (VictimPriority < Priority || (VictimPriority == Priority && VictimDistanceSquared > DistanceSquared.GetValue()));
+			if (!bMayEvict)
+			{
+				UE_LOG(LogAnimActorSys, Verbose, TEXT("Refused AnimActor for Guid %s, concurrency cap of %d reached."), *Guid.ToString(), Cap)
+				return false;
+			}
+			EvictAnimActor(FGuid(*Victim));
+		}
+	}
+
+	AnimActorSys::FAnimActorAdmission& Admission = Admissions.Add(Guid);
+	Admission.Class = ClassKey;
+	Admission.Asset = AssetKey;
+	Admission.Owner = Owner;
+	Admission.Priority = Priority;
+	Admission.Users = 1;
+	AdmissionsPerClass.FindOrAdd(ClassKey)++;
+	AdmissionsPerAsset.FindOrAdd(AssetKey)++;
+	return true;
+}
+
+void UAnimationActorSubsystem::RemoveAdmission(const FGuid& Guid)
+{
+	AnimActorSys::FAnimActorAdmission Admission;
+	if (!Admissions.RemoveAndCopyValue(Guid, Admission))
+	{
+		return;
+	}
+	if (int32* ClassCount = AdmissionsPerClass.Find(Admission.Class); ClassCount && --*ClassCount <= 0)
+	{
+		AdmissionsPerClass.Remove(Admission.Class);
+	}
+	if (int32* AssetCount = AdmissionsPerAsset.Find(Admission.Asset); AssetCount && --*AssetCount <= 0)
+	{
+		AdmissionsPerAsset.Remove(Admission.Asset);
+	}
+}
+
+void UAnimationActorSubsystem::EvictAnimActor(const FGuid& Guid)
+{
+	const AnimActorSys::FAnimActorAdmission* Admission = Admissions.Find(Guid);
+	const int32 Users = Admission ? Admission->Users : 0;
+	UE_LOG(LogAnimActorSys, Verbose, TEXT("Evicting AnimActor for Guid %s with %d users."), *Guid.ToString(), Users)
+	
+	for (int32 User = 0; User < Users; ++User)
+	{
+		ReleaseAnimActorUser(Guid);
+	}
+	SkippedSpawns.FindOrAdd(Guid) += Users;
+}
+
+void UAnimationActorSubsystem::SkipAnimActor(const FGuid& Guid)
+{
+	SkippedSpawns.FindOrAdd(Guid)++;
+}
+
+void UAnimationActorSubsystem::CancelAnimActor(const FGuid& Guid)
+{
+	if (AnimActorSys::FAnimActorAdmission* Admission = Admissions.Find(Guid); Admission && --Admission->Users <= 0)
+	{
+		RemoveAdmission(Guid);
+	}
+	SkipAnimActor(Guid);
+}
+
+void UAnimationActorSubsystem::BeginPendingLoad(const FGuid& Guid)
+{
+	PendingLoads.FindOrAdd(Guid).Pending++;
+}
+
+bool UAnimationActorSubsystem::FinishPendingLoad(const FGuid& Guid)
+{
+	AnimActorSys::FPendingLoad* PendingLoad = PendingLoads.Find(Guid);
+	if (!PendingLoad)
+	{
+		return true;
+	}
+	const bool bCancelled = PendingLoad->Cancelled > 0;
+	if (bCancelled)
+	{
+		PendingLoad->Cancelled--;
+	}
+	else
+	{
+		PendingLoad->Pending--;
+	}
+	if (PendingLoad->Pending <= 0 && PendingLoad->Cancelled <= 0)
+	{
+		PendingLoads.Remove(Guid);
+	}
+	return !bCancelled;
+}
+
+void UAnimationActorSubsystem::TrackSignificance(const FGuid& Guid, USkeletalMeshComponent* Owner)
+{
+	if (AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Registry.Find(Guid)))
+	{
+		Slot->SignificanceOwner = Owner;
+		UpdateSlotSignificance(*Slot);
+	}
+}
+
+void UAnimationActorSubsystem::UpdateSignificance()
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	if (!Settings->bEnableSignificance || WorldTime - LastSignificanceUpdateTime < Settings->SignificanceUpdateInterval)
+	{
+		return;
+	}
+	LastSignificanceUpdateTime = WorldTime;
+	
+	Registry.ForEach([this](AnimActorSys::FAnimActorHandle, AnimActorSys::FAnimActorSlot& Slot)
+	{
+		if (Slot.SignificanceOwner.IsValid())
+		{
+			UpdateSlotSignificance(Slot);
+		}
+	});
+}
+
+void UAnimationActorSubsystem::UpdateSlotSignificance(AnimActorSys::FAnimActorSlot& Slot) const
+{
+	const EAnimActorSignificance Significance = EvaluateSignificance(Slot.SignificanceOwner.Get());
+	if (Significance != Slot.Significance)
+	{
+		ApplySignificance(Slot.Counter.GetActor(), Slot.Component.Get(), Significance, Slot.SignificanceRestoreState);
+		Slot.Significance = Significance;
+	}
+}
+
+namespace AnimActorSys
+{
+	/** Whether Actor's class enables collision. Pooled and pre-spawned actors get their collision disabled while they're unused. */
+	static bool GetDefaultActorEnableCollision(const AActor* Actor)
+	{
+		return Actor->GetClass()->GetDefaultObject<AActor>()->GetActorEnableCollision();
+	}
+}
+
+void UAnimationActorSubsystem::ApplySignificance(AActor* Actor, UPrimitiveComponent* Component,
+                                                 const EAnimActorSignificance Significance,
+                                                 AnimActorSys::FSignificanceRestoreState& RestoreState)
+{
+	const bool bReduce = Significance != EAnimActorSignificance::Full;
+	const bool bHide = Significance == EAnimActorSignificance::Skip;
+	if (!Component && !IsValid(Actor))
+	{
+		return;
+	}
+
+	// Whatever is set up now is what the notify spawned it with, so that's what Full returns to.
+	if (bReduce && !RestoreState.bSaved)
+	{
+		RestoreState.bSaved = true;
+		RestoreState.bActorEnableCollision = Component || Actor->GetActorEnableCollision();
+		auto SavePrimitive = [&RestoreState](UPrimitiveComponent* Primitive)
+		{
+			AnimActorSys::FSignificanceRestoreState::FPrimitiveState& State = RestoreState.Primitives.AddDefaulted_GetRef();
+			State.Component = Primitive;
+			State.bCastShadow = Primitive->CastShadow;
+			if (const USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(Primitive))
+			{
+				State.ForcedLOD = SkeletalComp->GetForcedLOD();
+				State.bPauseAnims = SkeletalComp->bPauseAnims;
+			}
+			else if (const UStaticMeshComponent* StaticComp = Cast<UStaticMeshComponent>(Primitive))
+			{
+				State.ForcedLOD = StaticComp->ForcedLodModel;
+			}
+		};
+		if (Component)
+		{
+			SavePrimitive(Component);
+		}
+		else
+		{
+			Actor->ForEachComponent<UPrimitiveComponent>(false, SavePrimitive);
+		}
+	}
+
+	if (bReduce)
+	{
+		auto ReducePrimitive = [](UPrimitiveComponent* Primitive)
+		{
+			Primitive->SetCastShadow(false);
+			if (UAnimationActorSkeletalMeshComponent* AnimActorComp = Cast<UAnimationActorSkeletalMeshComponent>(Primitive))
+			{
+				// Keeps following its source's LOD from overriding the lowest LOD.
+				AnimActorComp->SetSignificanceLOD(AnimActorComp->GetNumLODs());
+				AnimActorComp->bPauseAnims = true;
+			}
+			else if (USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(Primitive))
+			{
+				SkeletalComp->SetForcedLOD(SkeletalComp->GetNumLODs());
+				SkeletalComp->bPauseAnims = true;
+			}
+			else if (UStaticMeshComponent* StaticComp = Cast<UStaticMeshComponent>(Primitive))
+			{
+				const UStaticMesh* Mesh = StaticComp->GetStaticMesh();
+				StaticComp->SetForcedLodModel(Mesh ? Mesh->GetNumLODs() : 0);
+			}
+		};
+		if (Component)
+		{
+			ReducePrimitive(Component);
+		}
+		else
+		{
+			Actor->ForEachComponent<UPrimitiveComponent>(false, ReducePrimitive);
+		}
+	}
+	else if (RestoreState.bSaved)
+	{
+		for (const AnimActorSys::FSignificanceRestoreState::FPrimitiveState& State : RestoreState.Primitives)
+		{
+			UPrimitiveComponent* Primitive = State.Component.Get();
+			if (!Primitive)
+			{
+				continue;
+			}
+			Primitive->SetCastShadow(State.bCastShadow);
+			if (UAnimationActorSkeletalMeshComponent* AnimActorComp = Cast<UAnimationActorSkeletalMeshComponent>(Primitive))
+			{
+				AnimActorComp->SetSignificanceLOD(0);
+			}
+			if (USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(Primitive))
+			{
+				SkeletalComp->SetForcedLOD(State.ForcedLOD);
+				SkeletalComp->bPauseAnims = State.bPauseAnims;
+			}
+			else if (UStaticMeshComponent* StaticComp = Cast<UStaticMeshComponent>(Primitive))
+			{
+				StaticComp->SetForcedLodModel(State.ForcedLOD);
+			}
+		}
+	}
+
+	if (Component)
+	{
+		// The notify configures the collision of its component, so that's left alone here.
+		Component->SetVisibility(!bHide);
+	}
+	else
+	{
+		Actor->SetActorHiddenInGame(bHide);
+		if (bReduce || RestoreState.bSaved)
+		{
+			Actor->SetActorEnableCollision(!bReduce && RestoreState.bActorEnableCollision);
+		}
+	}
+
+	if (!bReduce)
+	{
+		RestoreState.Reset();
+	}
+}
+
+void UAnimationActorSubsystem::ApplyScalabilityChanges()
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	
+	if (const float TickInterval = Settings->GetAnimActorTickInterval(); TickInterval != AppliedTickInterval)
+	{
+		AppliedTickInterval = TickInterval;
+		Registry.ForEach([TickInterval](AnimActorSys::FAnimActorHandle, AnimActorSys::FAnimActorSlot& Slot)
+		{
+			ApplyTickInterval(Slot.Counter.GetActor(), Slot.Component.Get(), TickInterval);
+		});
+	}
+
+	// Growing pools happens naturally as actors get released, shrinking them has to be done here.
+	if (const float PoolSizeScale = Settings->GetPoolSizeScale(); PoolSizeScale != AppliedPoolSizeScale)
+	{
+		AppliedPoolSizeScale = PoolSizeScale;
+		for (auto& [PooledClass, Pool] : ActorPools)
+		{
+			const int32 MaxPoolSize = Settings->GetPoolSettingsForClass(PooledClass).MaxPoolSize;
+			while (Pool.Num() > MaxPoolSize)
+			{
+				if (AActor* Actor = Pool.Pop())
+				{
+					Actor->Destroy();
+				}
+			}
+		}
+	}
+}
+
+void UAnimationActorSubsystem::ApplyTickInterval(AActor* Actor, UActorComponent* Component, const float TickInterval)
+{
+	if (Component)
+	{
+		Component->SetComponentTickInterval(TickInterval);
+		return;
+	}
+	if (IsValid(Actor))
+	{
+		Actor->SetActorTickInterval(TickInterval);
+		Actor->ForEachComponent(false, [TickInterval](UActorComponent* ActorComponent)
+		{
+			ActorComponent->SetComponentTickInterval(TickInterval);
+		});
+	}
+}
+
+void UAnimationActorSubsystem::RegisterLookaheadComponent(USkeletalMeshComponent* Component)
+{
+	if (Component)
+	{
+		LookaheadComponents.AddUnique(Component);
+	}
+}
+
+void UAnimationActorSubsystem::UnregisterLookaheadComponent(USkeletalMeshComponent* Component)
+{
+	LookaheadComponents.RemoveSingleSwap(Component, EAllowShrinking::No);
+}
+
+void UAnimationActorSubsystem::UpdateLookahead()
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	if (LookaheadComponents.IsEmpty() || Settings->LookaheadWindowSeconds <= 0.f || !Settings->IsSystemEnabled())
+	{
+		return;
+	}
+	
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	for (int32 ComponentIndex = LookaheadComponents.Num() - 1; ComponentIndex >= 0; --ComponentIndex)
+	{
+		USkeletalMeshComponent* MeshComp = LookaheadComponents[ComponentIndex].Get();
+		if (!MeshComp)
+		{
+			LookaheadComponents.RemoveAtSwap(ComponentIndex, 1, EAllowShrinking::No);
+			continue;
+		}
+		const UAnimInstance* AnimInstance = MeshComp->GetAnimInstance();
+		if (!AnimInstance)
+		{
+			continue;
+		}
+		
+		for (const FAnimMontageInstance* MontageInstance : AnimInstance->MontageInstances)
+		{
+			// Only forward playback is predictable enough to be worth preparing for.
+			const float PlayRate = MontageInstance ? MontageInstance->GetPlayRate() : 0.f;
+			if (!MontageInstance || !MontageInstance->Montage || !MontageInstance->IsPlaying() || PlayRate <= 0.f)
+			{
+				continue;
+			}
+			
+			const float Position = MontageInstance->GetPosition();
+			const float WindowEnd = Position + Settings->LookaheadWindowSeconds * PlayRate;
+			for (const FAnimNotifyEvent& NotifyEvent : MontageInstance->Montage->Notifies)
+			{
+				const float TriggerTime = NotifyEvent.GetTriggerTime();
+				UAnimNotifyState_SpawnActorBase* SpawnNotify = Cast<UAnimNotifyState_SpawnActorBase>(NotifyEvent.NotifyStateClass);
+				if (!SpawnNotify || TriggerTime <= Position || TriggerTime > WindowEnd || SpawnNotify->IsSkippedOnServer(MeshComp))
+				{
+					continue;
+				}
+				
+				const FGuid Guid = SpawnNotify->ConstructDeterministicGuidFromComponent(MeshComp);
+				if (LookaheadEntries.Contains(Guid) || Registry.Contains(Guid))
+				{
+					continue;
+				}
+				
+				AnimActorSys::FLookaheadEntry& Entry = LookaheadEntries.Add(Guid);
+				Entry.ExpireTime = WorldTime + (TriggerTime - Position) / PlayRate + Settings->LookaheadWindowSeconds;
+				Entry.Class = SpawnNotify->GetSpawnableClassToLoad();
+				Entry.bWantsPreSpawn = Settings->bPreSpawnInLookahead && SpawnNotify->SpawnsActor() && !Entry.Class.IsNull();
+				
+				TArray<FSoftObjectPath> Dependencies;
+				SpawnNotify->GatherSpawnDependencies(Dependencies);
+				if (!Dependencies.IsEmpty())
+				{
+					Entry.StreamingHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(Dependencies));
+				}
+			}
+		}
+	}
+}
+
+void UAnimationActorSubsystem::ProcessLookaheadEntries()
+{
+	const double WorldTime = GetWorld()->GetTimeSeconds();
+	for (auto It = LookaheadEntries.CreateIterator(); It; ++It)
+	{
+		AnimActorSys::FLookaheadEntry& Entry = It->Value;
+		if (WorldTime > Entry.ExpireTime)
+		{
+			// The notify never triggered, e.g. because the montage got interrupted.
+			if (AActor* Actor = Entry.PreSpawnedActor.Get(); IsValid(Actor))
+			{
+				ReleaseOrDestroy(Actor);
+			}
+			if (Entry.StreamingHandle)
+			{
+				Entry.StreamingHandle->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+			continue;
+		}
+		
+		UClass* Class = Entry.Class.Get();
+		if (!Entry.bWantsPreSpawn || !Class || !HasFrameBudgetLeft())
+		{
+			continue;
+		}
+		Entry.bWantsPreSpawn = false;
+		
+		const double StartTime = FPlatformTime::Seconds();
+		MarkClassReferenced(Class);
+		AActor* Actor = AcquireFromPool(Class, FTransform::Identity);
+		if (!Actor)
+		{
+			Actor = SpawnNewAnimActor(Class, FTransform::Identity);
+		}
+		if (Actor)
+		{
+			Actor->SetActorHiddenInGame(true);
+			Actor->SetActorEnableCollision(false);
+			Entry.PreSpawnedActor = Actor;
+		}
+		FrameBudgetSpentSeconds += FPlatformTime::Seconds() - StartTime;
+		FrameBudgetOperationCount++;
+	}
+}
+
+AActor* UAnimationActorSubsystem::TakePreSpawnedActor(const FGuid& Guid, const TSubclassOf<AActor>& Class,
+                                                      const FTransform& Transform)
+{
+	AnimActorSys::FLookaheadEntry Entry;
+	if (!LookaheadEntries.RemoveAndCopyValue(Guid, Entry))
+	{
+		return nullptr;
+	}
+	if (Entry.StreamingHandle)
+	{
+		Entry.StreamingHandle->ReleaseHandle();
+	}
+	
+	AActor* Actor = Entry.PreSpawnedActor.Get();
+	if (!IsValid(Actor))
+	{
+		return nullptr;
+	}
+	if (Actor->GetClass() != Class)
+	{
+		ReleaseOrDestroy(Actor);
+		return nullptr;
+	}
+
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(AnimActorSys::GetDefaultActorEnableCollision(Actor));
+	return Actor;
+}
+
+UPrimitiveComponent* UAnimationActorSubsystem::SpawnAnimComponent(const TSubclassOf<UPrimitiveComponent>& Class,
+                                                                  USkeletalMeshComponent* AttachParent,
+                                                                  const FName Bone,
+                                                                  const FTransform& RelativeTransform,
+                                                                  const bool bWeldSimulatedBodies,
+                                                                  const FGuid Guid,
+                                                                  const TFunction<void(UPrimitiveComponent*)>& PreRegistration)
+{
+	ANIMACTORSYS_SCOPE(SpawnAnimActor, Guid);
+	
+	AActor* Owner = AttachParent ? AttachParent->GetOwner() : nullptr;
+	if (!Class || !Owner || GetWorld()->bIsTearingDown)
+	{
+		return nullptr;
+	}
+
+	if (AnimActorSys::FAnimActorSlot* FoundSlot = Registry.Resolve(Registry.Find(Guid)))
+	{
+		if (UPrimitiveComponent* FoundComponent = FoundSlot->Component.Get())
+		{
+			FoundSlot->Counter.Increment();
+			return FoundComponent;
+		}
+		Registry.Remove(Registry.Find(Guid));
+	}
+
+	const FAttachmentTransformRules Rule = FAttachmentTransformRules(EAttachmentRule::KeepRelative, bWeldSimulatedBodies);
+	UPrimitiveComponent* Component = AcquireComponentFromPool(Owner, Class);
+	RecordPoolAccess(Component != nullptr);
+	if (Component)
+	{
+		if (PreRegistration)
+		{
+			PreRegistration(Component);
+		}
+		Component->SetRelativeTransform(RelativeTransform);
+		Component->AttachToComponent(AttachParent, Rule, Bone);
+	}
+	else
+	{
+		Component = NewObject<UPrimitiveComponent>(Owner, Class, NAME_None, RF_Transient);
+		Component->ComponentTags.AddUnique(SpawnedAnimActorTag);
+		Component->SetMobility(EComponentMobility::Movable);
+		Component->SetRelativeTransform(RelativeTransform);
+		Component->SetupAttachment(AttachParent, Bone);
+		if (PreRegistration)
+		{
+			PreRegistration(Component);
+		}
+		Component->RegisterComponent();
+		if (bWeldSimulatedBodies)
+		{
+			// SetupAttachment doesn't weld, so redo the attachment with the rule.
+			Component->AttachToComponent(AttachParent, Rule, Bone);
+		}
+		Owner->AddInstanceComponent(Component);
+	}
+	ApplyTickInterval(nullptr, Component, UAnimationActorSystemSettings::Get()->GetAnimActorTickInterval());
+
+	const AnimActorSys::FAnimActorHandle Handle = Registry.Add(Guid, nullptr);
+	AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Handle);
+	Slot->Counter.Increment();
+	Slot->Component = Component;
+	return Component;
+}
+
+USceneComponent* UAnimationActorSubsystem::GetAnimComponentByGuid(const FGuid& Guid) const
+{
+	if (const AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Registry.Find(Guid)))
+	{
+		if (UPrimitiveComponent* Component = Slot->Component.Get())
+		{
+			return Component;
+		}
+		if (const AActor* Actor = Slot->Counter.GetActor())
+		{
+			return Actor->GetRootComponent();
+		}
+	}
+	return nullptr;
+}
+
+namespace AnimActorSys
+{
+	/** Undoes what a notify's FAnimActorSpawnProfile may have changed on a pooled component. */
+	static void RestoreSpawnProfileDefaults(UPrimitiveComponent* Component, const UPrimitiveComponent* Defaults)
+	{
+		Component->SetCollisionProfileName(Defaults->GetCollisionProfileName(), false);
+		Component->PrimaryComponentTick.bStartWithTickEnabled = Defaults->PrimaryComponentTick.bStartWithTickEnabled;
+		Component->SetGenerateOverlapEvents(Defaults->GetGenerateOverlapEvents());
+		Component->SetCastShadow(Defaults->CastShadow);
+		Component->SetReceivesDecals(Defaults->bReceivesDecals);
+	}
+
+	/** Undoes what the skeletal mesh notify may have set up on a pooled mesh, so nothing keeps following the mesh that spawned it
+	 * and the next notify starts from the defaults, whichever AnimationMode it uses. */
+	static void ResetPooledSkeletalMesh(USkeletalMeshComponent* Component)
+	{
+		Component->SetLeaderPoseComponent(nullptr);
+		Component->Stop();
+		if (UAnimationActorAnimInstance* AnimInstance = Cast<UAnimationActorAnimInstance>(Component->GetAnimInstance()))
+		{
+			AnimInstance->ClearSync();
+		}
+		if (UAnimationActorSkeletalMeshComponent* AnimActorComp = Cast<UAnimationActorSkeletalMeshComponent>(Component))
+		{
+			AnimActorComp->SetUpdateRateSource(nullptr);
+		}
+		if (const USkeletalMeshComponent* Defaults = Cast<USkeletalMeshComponent>(Component->GetArchetype()))
+		{
+			// Setting a class switches to the blueprint mode, so the mode goes second.
+			Component->SetAnimInstanceClass(Defaults->AnimClass);
+			Component->SetAnimationMode(Defaults->GetAnimationMode());
+		}
+	}
+}
+
+UPrimitiveComponent* UAnimationActorSubsystem::AcquireComponentFromPool(AActor* Owner,
+                                                                         const TSubclassOf<UPrimitiveComponent>& Class)
+{
+	TArray<TWeakObjectPtr<UPrimitiveComponent>>* Pool = ComponentPools.Find({Owner, Class.Get()});
+	while (Pool && !Pool->IsEmpty())
+	{
+		UPrimitiveComponent* Component = Pool->Pop(EAllowShrinking::No).Get();
+		if (IsValid(Component))
+		{
+			AnimActorSys::RestoreSpawnProfileDefaults(Component, Class->GetDefaultObject<UPrimitiveComponent>());
+			Component->SetVisibility(true);
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+			return Component;
+		}
+	}
+	return nullptr;
+}
+
+void UAnimationActorSubsystem::ReleaseAnimComponent(UPrimitiveComponent* Component)
+{
+	AActor* Owner = Component->GetOwner();
+	const int32 MaxPoolSize = UAnimationActorSystemSettings::Get()->bEnableActorPooling
+		? UAnimationActorSystemSettings::Get()->MaxPooledComponentsPerOwner : 0;
+	
+	TArray<TWeakObjectPtr<UPrimitiveComponent>>* Pool = nullptr;
+	if (Owner && MaxPoolSize > 0 && !GetWorld()->bIsTearingDown)
+	{
+		const TPair<TObjectKey<AActor>, TObjectKey<UClass>> PoolKey(Owner, Component->GetClass());
+		Pool = ComponentPools.Find(PoolKey);
+		if (!Pool)
+		{
+			// Owners come and go, so get rid of the pools of those that are gone before adding a new one.
+			for (auto It = ComponentPools.CreateIterator(); It; ++It)
+			{
+				if (!It->Key.Key.ResolveObjectPtr())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			Pool = &ComponentPools.Add(PoolKey);
+		}
+	}
+	
+	if (!Pool || Pool->Num() >= MaxPoolSize)
+	{
+		if (Owner)
+		{
+			Owner->RemoveInstanceComponent(Component);
+		}
+		Component->DestroyComponent();
+		return;
+	}
+
+	Component->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
+	Component->SetVisibility(false);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetComponentTickEnabled(false);
+	if (USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(Component))
+	{
+		AnimActorSys::ResetPooledSkeletalMesh(SkeletalComp);
+	}
+	Pool->Emplace(Component);
+}
+
+bool UAnimationActorSubsystem::AddAnimActorInstance(UStaticMesh* Mesh, USkeletalMeshComponent* AttachParent,
+                                                    const FName Bone, const FTransform& RelativeTransform,
+                                                    const FGuid Guid)
+{
+	ANIMACTORSYS_SCOPE(SpawnAnimActor, Guid);
+	
+	if (!Mesh || !AttachParent || GetWorld()->bIsTearingDown)
+	{
+		return false;
+	}
+	
+	if (AnimActorSys::FAnimActorSlot* FoundSlot = Registry.Resolve(Registry.Find(Guid)))
+	{
+		FoundSlot->Counter.Increment();
+		return true;
+	}
+
+	const int32 BatchIndex = FindOrAddInstanceBatch(Mesh);
+	AnimActorSys::FInstanceBatch& Batch = InstanceBatches[BatchIndex];
+	UInstancedStaticMeshComponent* Component = Batch.Component.Get();
+	if (!Component)
+	{
+		return false;
+	}
+	
+	const FTransform WorldTransform = RelativeTransform * AttachParent->GetSocketTransform(Bone);
+	const int32 InstanceIndex = Component->AddInstance(WorldTransform, true);
+	check(InstanceIndex == Batch.Owners.Num())
+
+	const AnimActorSys::FAnimActorHandle Handle = Registry.Add(Guid, nullptr);
+	AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Handle);
+	Slot->Counter.Increment();
+	Slot->InstanceBatchIndex = BatchIndex;
+	Slot->InstanceIndex = InstanceIndex;
+
+	Batch.Owners.Add(Handle);
+	Batch.AttachParents.Add(AttachParent);
+	Batch.AttachBones.Add(Bone);
+	Batch.RelativeTransforms.Add(RelativeTransform);
+	return true;
+}
+
+int32 UAnimationActorSubsystem::FindOrAddInstanceBatch(UStaticMesh* Mesh)
+{
+	if (const int32* ExistingIndex = InstanceBatchIndices.Find(Mesh))
+	{
+		return *ExistingIndex;
+	}
+
+	if (!InstanceHostActor)
+	{
+		FActorSpawnParameters Params = FActorSpawnParameters();
+		Params.ObjectFlags |= RF_Transient;
+		InstanceHostActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		InstanceHostActor->Tags.AddUnique(SpawnedAnimActorTag);
+		USceneComponent* Root = NewObject<USceneComponent>(InstanceHostActor, TEXT("Root"), RF_Transient);
+		InstanceHostActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(InstanceHostActor, NAME_None, RF_Transient);
+	Component->SetStaticMesh(Mesh);
+	Component->SetMobility(EComponentMobility::Movable);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetCanEverAffectNavigation(false);
+	// Lets us remove instances in O(1). The arrays in the FInstanceBatch mirror the swap.
+	Component->bSupportRemoveAtSwap = true;
+	Component->SetupAttachment(InstanceHostActor->GetRootComponent());
+	Component->RegisterComponent();
+	InstanceHostActor->AddInstanceComponent(Component);
+
+	AnimActorSys::FInstanceBatch& Batch = InstanceBatches.AddDefaulted_GetRef();
+	Batch.Component = Component;
+	return InstanceBatchIndices.Add(Mesh, InstanceBatches.Num() - 1);
+}
+
+void UAnimationActorSubsystem::RemoveAnimActorInstance(const AnimActorSys::FAnimActorSlot& Slot)
+{
+	AnimActorSys::FInstanceBatch& Batch = InstanceBatches[Slot.InstanceBatchIndex];
+	const int32 InstanceIndex = Slot.InstanceIndex;
+	if (UInstancedStaticMeshComponent* Component = Batch.Component.Get())
+	{
+		Component->RemoveInstance(InstanceIndex);
+	}
+	
+	Batch.Owners.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+	Batch.AttachParents.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+	Batch.AttachBones.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+	Batch.RelativeTransforms.RemoveAtSwap(InstanceIndex, 1, EAllowShrinking::No);
+	
+	// The last instance took the place of the removed one.
+	if (Batch.Owners.IsValidIndex(InstanceIndex))
+	{
+		if (AnimActorSys::FAnimActorSlot* MovedSlot = Registry.Resolve(Batch.Owners[InstanceIndex]))
+		{
+			MovedSlot->InstanceIndex = InstanceIndex;
+		}
+	}
+}
+
+void UAnimationActorSubsystem::UpdateInstanceTransforms()
+{
+	for (AnimActorSys::FInstanceBatch& Batch : InstanceBatches)
+	{
+		UInstancedStaticMeshComponent* Component = Batch.Component.Get();
+		const int32 NumInstances = Batch.Owners.Num();
+		if (!Component || NumInstances == 0)
+		{
+			continue;
+		}
+		
+		Batch.WorldTransforms.SetNumUninitialized(NumInstances, EAllowShrinking::No);
+		
+		// Only reads the already finished bone transforms of the attach parents, so this is safe to do in parallel.
+		constexpr int32 MinInstancesPerTask = 64;
+		ParallelFor(TEXT("AnimActorSys.UpdateInstanceTransforms"), NumInstances, MinInstancesPerTask,
+			[&Batch, Component](const int32 Index)
+			{
+				if (const USkeletalMeshComponent* Parent = Batch.AttachParents[Index].Get())
+				{
+					Batch.WorldTransforms[Index] = Batch.RelativeTransforms[Index] * Parent->GetSocketTransform(Batch.AttachBones[Index]);
+				}
+				else
+				{
+					Component->GetInstanceTransform(Index, Batch.WorldTransforms[Index], true);
+				}
+			});
+		
+		Component->BatchUpdateInstancesTransforms(0, Batch.WorldTransforms, true, true, true);
+	}
+}
+
+TStatId UAnimationActorSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UAnimationActorSubsystem, STATGROUP_Tickables);
+}
+
+AActor* UAnimationActorSubsystem::SpawnNewAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform,
+                                                    const TFunction<void(AActor*)>& PreSpawnInitialization) const
+{
+	FActorSpawnParameters Params = FActorSpawnParameters();
+	Params.ObjectFlags |= RF_Transient;
+	// Runs before the components are registered, so their render and physics state is created with the final configuration.
+	Params.CustomPreSpawnInitalization = [&PreSpawnInitialization](AActor* Actor)
+	{
+		Actor->Tags.AddUnique(SpawnedAnimActorTag);
+		if (PreSpawnInitialization)
+		{
+			PreSpawnInitialization(Actor);
+		}
+	};
+	return GetWorld()->SpawnActor(Class, &Transform, Params);
+}
+
+AActor* UAnimationActorSubsystem::AcquireFromPool(const TSubclassOf<AActor>& Class, const FTransform& Transform)
+{
+	AnimActorSys::FActorPool* Pool = ActorPools.Find(Class);
+	AActor* Actor = Pool ? Pool->Pop() : nullptr;
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+	Actor->SetActorHiddenInGame(false);
+	Actor->SetActorEnableCollision(AnimActorSys::GetDefaultActorEnableCollision(Actor));
+	Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+	// A spawn profile of the previous user may have stopped them, see ReleaseToPool() for the restored defaults.
+	Actor->ForEachComponent<UActorComponent>(false, [](UActorComponent* Component)
+	{
+		Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+	});
+	
+	if (Actor->Implements<UAnimationActorPoolable>())
+	{
+		IAnimationActorPoolable::Execute_OnTakenFromPool(Actor);
+	}
+	return Actor;
+}
+
+namespace AnimActorSys
+{
+	/** Where Component plays its animation in sync with its owner, or false if it doesn't. */
+	static bool GetSharedPoseTime(const USkeletalMeshComponent* Component, float& OutTime)
+	{
+		const UAnimationActorAnimInstance* AnimInstance = Component ? Cast<UAnimationActorAnimInstance>(Component->GetAnimInstance()) : nullptr;
+		return AnimInstance && AnimInstance->GetNotifyStateTime(OutTime);
+	}
+
+	/** Hands the evaluation of a group over to its first follower that's still around.
+	 * @return false if none is left, and the group can be removed. */
+	static bool PromoteSharedPoseLeader(FSharedPoseGroup& Group)
+	{
+		Group.Leader = nullptr;
+		while (!Group.Followers.IsEmpty() && !Group.Leader.IsValid())
+		{
+			Group.Leader = Group.Followers[0];
+			Group.Followers.RemoveAt(0, EAllowShrinking::No);
+		}
+		USkeletalMeshComponent* NewLeader = Group.Leader.Get();
+		if (!NewLeader)
+		{
+			return false;
+		}
+		NewLeader->SetLeaderPoseComponent(nullptr);
+		for (const TWeakObjectPtr<USkeletalMeshComponent>& Follower : Group.Followers)
+		{
+			if (USkeletalMeshComponent* FollowerComp = Follower.Get())
+			{
+				FollowerComp->SetLeaderPoseComponent(NewLeader);
+			}
+		}
+		return true;
+	}
+}
+
+void UAnimationActorSubsystem::JoinSharedPoseGroup(USkeletalMeshComponent* Component, const UAnimSequenceBase* Animation)
+{
+	// Only meshes playing in sync with their owner can be matched by time.
+	const UAnimationActorAnimInstance* AnimInstance = Component ? Cast<UAnimationActorAnimInstance>(Component->GetAnimInstance()) : nullptr;
+	if (!UAnimationActorSystemSettings::Get()->bSharePoseEvaluation || !AnimInstance || !Animation)
+	{
+		return;
+	}
+
+	// Spawns usually happen right as the notify begins, before the owner lists it as active. That's the notify's start then.
+	float Time = 0.f;
+	if (!AnimInstance->GetNotifyStateTime(Time))
+	{
+		Time = 0.f;
+	}
+	AddToSharedPoseGroup(Component, Animation, Time);
+}
+
+void UAnimationActorSubsystem::AddToSharedPoseGroup(USkeletalMeshComponent* Component, const UAnimSequenceBase* Animation, const float Time)
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const UAnimSingleNodeInstance* AnimInstance = Component->GetSingleNodeInstance();
+	LeaveSharedPoseGroup(Component);
+	if (!AnimInstance)
+	{
+		return;
+	}
+
+	const TPair<FObjectKey, FObjectKey> Key(Component->GetSkeletalMeshAsset(), Animation);
+	TArray<AnimActorSys::FSharedPoseGroup>& Groups = SharedPoseGroups.FindOrAdd(Key);
+	SharedPoseGroupKeys.Add(Component, Key);
+	for (AnimActorSys::FSharedPoseGroup& Group : Groups)
+	{
+		USkeletalMeshComponent* Leader = Group.Leader.Get();
+		const UAnimSingleNodeInstance* LeaderInstance = Leader ? Leader->GetSingleNodeInstance() : nullptr;
+		float LeaderTime = 0.f;
+		if (LeaderInstance && LeaderInstance->IsLooping() == AnimInstance->IsLooping()
+			&& AnimActorSys::GetSharedPoseTime(Leader, LeaderTime)
+			&& FMath::Abs(LeaderTime - Time) <= Settings->SharedPoseTimeTolerance)
+		{
+			Component->SetLeaderPoseComponent(Leader);
+			Group.Followers.Emplace(Component);
+			return;
+		}
+	}
+	Groups.AddDefaulted_GetRef().Leader = Component;
+}
+
+void UAnimationActorSubsystem::LeaveSharedPoseGroup(USkeletalMeshComponent* Component)
+{
+	TPair<FObjectKey, FObjectKey> Key;
+	if (!SharedPoseGroupKeys.RemoveAndCopyValue(Component, Key))
+	{
+		return;
+	}
+	TArray<AnimActorSys::FSharedPoseGroup>* Groups = SharedPoseGroups.Find(Key);
+	if (!Groups)
+	{
+		return;
+	}
+
+	for (int32 GroupIndex = 0; GroupIndex < Groups->Num(); ++GroupIndex)
+	{
+		AnimActorSys::FSharedPoseGroup& Group = (*Groups)[GroupIndex];
+		if (Group.Followers.Remove(Component) > 0)
+		{
+			Component->SetLeaderPoseComponent(nullptr);
+			return;
+		}
+		if (Group.Leader != Component)
+		{
+			continue;
+		}
+
+		if (!AnimActorSys::PromoteSharedPoseLeader(Group))
+		{
+			Groups->RemoveAtSwap(GroupIndex, EAllowShrinking::No);
+			if (Groups->IsEmpty())
+			{
+				SharedPoseGroups.Remove(Key);
+			}
+		}
+		return;
+	}
+}
+
+void UAnimationActorSubsystem::UpdateSharedPoseGroups()
+{
+	if (SharedPoseGroups.IsEmpty())
+	{
+		return;
+	}
+	const float Tolerance = UAnimationActorSystemSettings::Get()->SharedPoseTimeTolerance;
+
+	for (auto It = SharedPoseGroupKeys.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Owners with different time dilation or paused montages drift apart. Those have to evaluate on their own again.
+	// Resolving a time means searching the owner's active notifies, so only the leader and one follower per group are checked each frame.
+	struct FDriftedFollower
+	{
+		USkeletalMeshComponent* Component;
+		const UAnimSequenceBase* Animation;
+		float Time;
+	};
+	TArray<FDriftedFollower, TInlineAllocator<8>> Drifted;
+	for (auto GroupsIt = SharedPoseGroups.CreateIterator(); GroupsIt; ++GroupsIt)
+	{
+		const TPair<FObjectKey, FObjectKey>& Key = GroupsIt->Key;
+		TArray<AnimActorSys::FSharedPoseGroup>& Groups = GroupsIt->Value;
+
+		// Leaders destroyed by something else than the subsystem never left their group.
+		Groups.RemoveAllSwap([](AnimActorSys::FSharedPoseGroup& Group)
+		{
+			return !Group.Leader.IsValid() && !AnimActorSys::PromoteSharedPoseLeader(Group);
+		});
+		if (Groups.IsEmpty())
+		{
+			GroupsIt.RemoveCurrent();
+			continue;
+		}
+
+		for (AnimActorSys::FSharedPoseGroup& Group : Groups)
+		{
+			Group.Followers.RemoveAll([](const TWeakObjectPtr<USkeletalMeshComponent>& Follower) { return !Follower.IsValid(); });
+			float LeaderTime = 0.f;
+			if (Group.Followers.IsEmpty() || !AnimActorSys::GetSharedPoseTime(Group.Leader.Get(), LeaderTime))
+			{
+				continue;
+			}
+			
+			Group.NextDriftCheck = Group.NextDriftCheck % Group.Followers.Num();
+			USkeletalMeshComponent* FollowerComp = Group.Followers[Group.NextDriftCheck++].Get();
+			float FollowerTime = 0.f;
+			if (AnimActorSys::GetSharedPoseTime(FollowerComp, FollowerTime) && FMath::Abs(FollowerTime - LeaderTime) > Tolerance)
+			{
+				Drifted.Add({FollowerComp, Cast<UAnimSequenceBase>(Key.Value.ResolveObjectPtr()), FollowerTime});
+			}
+		}
+	}
+
+	for (const FDriftedFollower& Follower : Drifted)
+	{
+		if (Follower.Animation)
+		{
+			AddToSharedPoseGroup(Follower.Component, Follower.Animation, Follower.Time);
+		}
 	}
-	
-	if (!Class)
+}
+
+TSharedRef<const AnimActorSys::FBoneIndexMap> UAnimationActorSubsystem::GetBoneIndexMap(const USkeletalMesh* Source,
+                                                                                       const USkeletalMesh* Target)
+{
+	const TPair<FObjectKey, FObjectKey> Key(Source, Target);
+	if (const TSharedRef<AnimActorSys::FBoneIndexMap>* ExistingMap = BoneIndexMaps.Find(Key))
 	{
-		return nullptr;
+		return *ExistingMap;
 	}
 
-	ReferencedAnimActorClasses.AddUnique(Class);
+	TSharedRef<AnimActorSys::FBoneIndexMap> Map = MakeShared<AnimActorSys::FBoneIndexMap>();
+	BoneIndexMaps.Add(Key, Map);
+	if (!Source || !Target)
+	{
+		Map->bReady.store(true, std::memory_order_release);
+		return Map;
+	}
 
-	UWorld* World = GetWorld();
-	checkf(World, TEXT("WorldSubsystems should not be able to exist without world."));
+	// The meshes may be garbage collected while the task runs, so it works on copies of the bone names.
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+	                  [Map, SourceBones = Source->GetRefSkeleton().GetRawRefBoneInfo(),
+	                   TargetBones = Target->GetRefSkeleton().GetRawRefBoneInfo()]
+	                  {
+		                  TMap<FName, int32> SourceIndices;
+		                  SourceIndices.Reserve(SourceBones.Num());
+		                  for (int32 Index = 0; Index < SourceBones.Num(); ++Index)
+		                  {
+			                  SourceIndices.Add(SourceBones[Index].Name, Index);
+		                  }
 
-	if(World->bIsTearingDown)
+		                  Map->SourceBoneIndices.SetNumUninitialized(TargetBones.Num());
+		                  for (int32 Index = 0; Index < TargetBones.Num(); ++Index)
+		                  {
+			                  const int32* SourceIndex = SourceIndices.Find(TargetBones[Index].Name);
+			                  Map->SourceBoneIndices[Index] = SourceIndex ? *SourceIndex : INDEX_NONE;
+		                  }
+		                  Map->bReady.store(true, std::memory_order_release);
+	                  });
+	return Map;
+}
+
+bool UAnimationActorSubsystem::ReleaseToPool(AActor* Actor)
+{
+	const FAnimActorPoolSettings PoolSettings = UAnimationActorSystemSettings::Get()->GetPoolSettingsForClass(Actor->GetClass());
+	if (PoolSettings.MaxPoolSize <= 0 || GetWorld()->bIsTearingDown)
 	{
-		return nullptr;
+		return false;
+	}
+	AnimActorSys::FActorPool& Pool = ActorPools.FindOrAdd(Actor->GetClass());
+	if (Pool.Num() >= PoolSettings.MaxPoolSize)
+	{
+		return false;
+	}
+
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+
+	// Undo what the notifies may have changed on the mesh actors, so the next notify starts from the class defaults.
+	if (const ASkeletalMeshActor* SkeletalMeshActor = Cast<ASkeletalMeshActor>(Actor))
+	{
+		AnimActorSys::ResetPooledSkeletalMesh(SkeletalMeshActor->GetSkeletalMeshComponent());
+	}
+	Actor->PrimaryActorTick.bStartWithTickEnabled = Actor->GetClass()->GetDefaultObject<AActor>()->PrimaryActorTick.bStartWithTickEnabled;
+	Actor->ForEachComponent<UPrimitiveComponent>(false, [](UPrimitiveComponent* Component)
+	{
+		if (const UPrimitiveComponent* Archetype = Cast<UPrimitiveComponent>(Component->GetArchetype()))
+		{
+			AnimActorSys::RestoreSpawnProfileDefaults(Component, Archetype);
+		}
+	});
+
+	if (Actor->Implements<UAnimationActorPoolable>())
+	{
+		IAnimationActorPoolable::Execute_OnReleasedToPool(Actor);
+	}
+	Pool.Push(Actor);
+	return true;
+}
+
+void UAnimationActorSubsystem::SyncLoadAssets(TConstArrayView<FSoftObjectPath> Paths)
+{
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		if (Path.ResolveObject())
+		{
+			continue;
+		}
+		const double StartTime = FPlatformTime::Seconds();
+		Path.TryLoad();
+		const float LoadTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+		
+		UE_LOG(LogAnimActorSys, Verbose, TEXT("Sync-loaded %s in %.2fms"), *Path.ToString(), LoadTimeMs)
+		PreloadCache.RecordSyncLoad(Path, LoadTimeMs);
+	}
+}
+
+void UAnimationActorSubsystem::KeepAssetsLoaded(TConstArrayView<FSoftObjectPath> Paths)
+{
+	for (const FSoftObjectPath& Path : Paths)
+	{
+		PreloadCache.MarkUsed(Path);
+		
+		// Actor classes are referenced once something gets spawned from them. Other classes, like anim blueprints, are assets as any other.
+		UObject* Asset = Path.ResolveObject();
+		if (const UClass* AssetClass = Cast<UClass>(Asset); Asset && !(AssetClass && AssetClass->IsChildOf<AActor>()))
+		{
+			ReferencedAnimAssets.Add(Asset);
+			ReferenceLastUseTimes.Add(Asset, FPlatformTime::Seconds());
+		}
+	}
+}
+
+void UAnimationActorSubsystem::MarkClassReferenced(const TSubclassOf<AActor>& Class)
+{
+	if (Class)
+	{
+		ReferencedAnimActorClasses.Add(Class);
+		ReferenceLastUseTimes.Add(Class.Get(), FPlatformTime::Seconds());
+	}
+}
+
+void UAnimationActorSubsystem::UpdateReferenceRelease()
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const bool bMemoryTrimRequested = bPendingMemoryTrim.exchange(false);
+	if (!Settings->bReleaseIdleReferences)
+	{
+		return;
+	}
+	if (bMemoryTrimRequested)
+	{
+		ReleaseIdleReferences(true);
+		return;
 	}
 	
-	if(AnimActorSys::FActorCounter* FoundCounter = SpawnedActors.Find(Guid))
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastReferenceReleaseCheckTime < Settings->ReferenceReleaseCheckInterval)
+	{
+		return;
+	}
+	LastReferenceReleaseCheckTime = Now;
+
+	const bool bMemoryPressure = Settings->LowMemoryThresholdMB > 0
+		&& FPlatformMemory::GetStats().AvailablePhysical < static_cast<uint64>(Settings->LowMemoryThresholdMB) * 1024 * 1024;
+	ReleaseIdleReferences(bMemoryPressure);
+}
+
+void UAnimationActorSubsystem::ReleaseIdleReferences(const bool bMemoryPressure)
+{
+	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();
+	const double ReleaseBefore = bMemoryPressure ? TNumericLimits<double>::Max()
+		: FPlatformTime::Seconds() - Settings->ReferenceIdleReleaseSeconds;
+	auto IsIdle = [this, ReleaseBefore](const UObject* Object)
 	{
-		if(AActor* Actor = FoundCounter->Increment())
+		const double* LastUseTime = ReferenceLastUseTimes.Find(Object);
+		return !LastUseTime || *LastUseTime < ReleaseBefore;
+	};
+
+	// Live and pooled actors keep their class loaded on their own, releasing it only allows unloading it once they're gone.
+	int32 ReleasedCount = 0;
+	for (auto It = ReferencedAnimActorClasses.CreateIterator(); It; ++It)
+	{
+		const UClass* Class = It->Get();
+		if (!Class || (IsIdle(Class) && !Settings->IsClassPreloadedOnBeginPlay(Class)))
 		{
-			return Actor;
+			ReferenceLastUseTimes.Remove(Class);
+			It.RemoveCurrent();
+			ReleasedCount++;
+		}
+	}
+	for (auto It = ReferencedAnimAssets.CreateIterator(); It; ++It)
+	{
+		if (!*It || IsIdle(*It))
+		{
+			ReferenceLastUseTimes.Remove(It->Get());
+			It.RemoveCurrent();
+			ReleasedCount++;
+		}
+	}
+
+	// The preload cache's assets may not have been needed yet, so they are only given up when memory is short.
+	if (bMemoryPressure && PreloadCacheHandle)
+	{
+		PreloadCacheHandle->ReleaseHandle();
+		PreloadCacheHandle.Reset();
+	}
+	// Anim instances keep the maps they use alive, the cache only has to share them while someone does.
+	if (bMemoryPressure)
+	{
+		BoneIndexMaps.Reset();
+	}
+	else
+	{
+		for (auto It = BoneIndexMaps.CreateIterator(); It; ++It)
+		{
+			if (It->Value.GetSharedReferenceCount() == 1)
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	if (ReleasedCount > 0)
+	{
+		UE_LOG(LogAnimActorSys, Verbose, TEXT("Released %d idle class and asset references%s."), ReleasedCount,
+		       bMemoryPressure ? TEXT(" due to memory pressure") : TEXT(""))
+	}
+}
+
+namespace AnimActorSys
+{
+	/** The mesh a spawned component renders, to group it by in the memory report. */
+	static FString GetReportedMeshName(const UPrimitiveComponent* Component)
+	{
+		const UObject* Mesh = nullptr;
+		if (const UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(Component))
+		{
+			Mesh = StaticMeshComponent->GetStaticMesh();
+		}
+		else if (const USkinnedMeshComponent* SkinnedMeshComponent = Cast<USkinnedMeshComponent>(Component))
+		{
+			Mesh = SkinnedMeshComponent->GetSkinnedAsset();
+		}
+		return Mesh ? Mesh->GetPathName() : FString();
+	}
+
+	/** Counts Actor with all its components in the row of its class and mesh. */
+	static void AddActorToReport(FMemoryReport& Report, const EMemoryReportCategory Category, const AActor* Actor)
+	{
+		const UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(Actor->GetRootComponent());
+		FMemoryReportRow& Row = Report.FindOrAddRow(Category, Actor->GetClass()->GetPathName(), GetReportedMeshName(Root));
+		Row.Count++;
+		FMemoryReport::AddResourceSize(Row, Actor);
+		Actor->ForEachComponent(false, [&Row](const UActorComponent* Component)
+		{
+			FMemoryReport::AddResourceSize(Row, Component);
+		});
+	}
+}
+
+void UAnimationActorSubsystem::GatherMemoryReport(AnimActorSys::FMemoryReport& OutReport) const
+{
+	using namespace AnimActorSys;
+
+	OutReport.World = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+	const double Now = FPlatformTime::Seconds();
+
+	Registry.ForEach([&OutReport](FAnimActorHandle, const FAnimActorSlot& Slot)
+	{
+		if (const AActor* Actor = Slot.Counter.GetActor())
+		{
+			AddActorToReport(OutReport, EMemoryReportCategory::Live, Actor);
+		}
+		else if (const UPrimitiveComponent* Component = Slot.Component.Get())
+		{
+			OutReport.Add(EMemoryReportCategory::Live, Component, Component->GetClass()->GetPathName(), GetReportedMeshName(Component));
+		}
+	});
+	// Instances are counted per instance, their component (holding the instance data) once per batch.
+	for (const FInstanceBatch& Batch : InstanceBatches)
+	{
+		if (const UInstancedStaticMeshComponent* Component = Batch.Component.Get(); Component && !Batch.Owners.IsEmpty())
+		{
+			FMemoryReportRow& Row = OutReport.FindOrAddRow(EMemoryReportCategory::Live, Component->GetClass()->GetPathName(),
+			                                               GetReportedMeshName(Component));
+			Row.Count += Batch.Owners.Num();
+			FMemoryReport::AddResourceSize(Row, Component);
+		}
+	}
+
+	for (const auto& [PoolClass, Pool] : ActorPools)
+	{
+		for (const TWeakObjectPtr<AActor>& WeakActor : Pool.GetInactiveActors())
+		{
+			if (const AActor* Actor = WeakActor.Get())
+			{
+				AddActorToReport(OutReport, EMemoryReportCategory::Pooled, Actor);
+			}
+		}
+	}
+	for (const auto& [PoolKey, Components] : ComponentPools)
+	{
+		for (const TWeakObjectPtr<UPrimitiveComponent>& WeakComponent : Components)
+		{
+			if (const UPrimitiveComponent* Component = WeakComponent.Get())
+			{
+				OutReport.Add(EMemoryReportCategory::Pooled, Component, Component->GetClass()->GetPathName(), GetReportedMeshName(Component));
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<AActor>& WeakActor : PendingReleases)
+	{
+		if (const AActor* Actor = WeakActor.Get())
+		{
+			AddActorToReport(OutReport, EMemoryReportCategory::Lingering, Actor);
+		}
+	}
+	for (const auto& [Guid, Entry] : LookaheadEntries)
+	{
+		if (const AActor* Actor = Entry.PreSpawnedActor.Get())
+		{
+			AddActorToReport(OutReport, EMemoryReportCategory::Lingering, Actor);
+		}
+	}
+
+	auto GetSecondsSinceLastUse = [this, Now](const UObject* Object)
+	{
+		const double* LastUseTime = ReferenceLastUseTimes.Find(Object);
+		return LastUseTime ? Now - *LastUseTime : -1.0;
+	};
+	for (const TSubclassOf<AActor>& Class : ReferencedAnimActorClasses)
+	{
+		if (Class)
+		{
+			// The class itself is tiny, but it keeps its default object and everything that references alive.
+			OutReport.Add(EMemoryReportCategory::ReferencedClass, Class->GetDefaultObject(), Class->GetPathName(), FString(),
+			              GetSecondsSinceLastUse(Class.Get()), EResourceSizeMode::EstimatedTotal);
+		}
+	}
+	for (const TObjectPtr<UObject>& Asset : ReferencedAnimAssets)
+	{
+		if (Asset)
+		{
+			OutReport.Add(EMemoryReportCategory::ReferencedAsset, Asset, Asset->GetClass()->GetPathName(), Asset->GetPathName(),
+			              GetSecondsSinceLastUse(Asset), EResourceSizeMode::EstimatedTotal);
 		}
 	}
+}
+
+void UAnimationActorSubsystem::PrewarmPool(const TSubclassOf<AActor>& Class, int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (!Class || World->bIsTearingDown || GIsCookerLoadingPackage || IsRunningCookCommandlet())
+	{
+		return;
+	}
 	
-	FActorSpawnParameters Params = FActorSpawnParameters();
-	Params.ObjectFlags = Params.ObjectFlags & RF_Transient;
-	if (AActor* SpawnedActor = World->SpawnActor(Class, &Transform, Params))
+	MarkClassReferenced(Class);
+	
+	const FAnimActorPoolSettings PoolSettings = UAnimationActorSystemSettings::Get()->GetPoolSettingsForClass(Class);
+	const int32 TargetCount = FMath::Min(Count, PoolSettings.MaxPoolSize);
+	const AnimActorSys::FActorPool* Pool = ActorPools.Find(Class);
+	for (int32 PoolCount = Pool ? Pool->Num() : 0; PoolCount < TargetCount; ++PoolCount)
 	{
-		SpawnedActors.Emplace(Guid, AnimActorSys::FActorCounter(SpawnedActor)).Increment();
-		SpawnedActor->Tags.AddUnique(SpawnedAnimActorTag);
-		return SpawnedActor;
+		AActor* PrewarmedActor = SpawnNewAnimActor(Class, FTransform::Identity);
+		if (!PrewarmedActor || !ReleaseToPool(PrewarmedActor))
+		{
+			break;
+		}
+	}
+}
+
+void UAnimationActorSubsystem::PrewarmPoolFromSettings(const TSubclassOf<AActor>& Class)
+{
+	if (Class)
+	{
+		PrewarmPool(Class, UAnimationActorSystemSettings::Get()->GetPoolSettingsForClass(Class).PrewarmCount);
 	}
-	return nullptr;
 }
 
 AActor* UAnimationActorSubsystem::GetAnimActorByGuid(const FGuid& GuidToLookFor) const
 {
-	if (const AnimActorSys::FActorCounter* Counter = SpawnedActors.Find(GuidToLookFor))
+	if (const AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Registry.Find(GuidToLookFor)))
 	{
-		return Counter->GetActor();
+		return Slot->Counter.GetActor();
 	}
 	return nullptr;
 }
 
 void UAnimationActorSubsystem::DestroyAnimActor(const FGuid Guid)
 {
-	if (AnimActorSys::FActorCounter* ActorCounter = SpawnedActors.Find(Guid))
-	{		
+	ANIMACTORSYS_SCOPE(DestroyAnimActor, Guid);
+	
+	if (int32* SkippedCount = SkippedSpawns.Find(Guid))
+	{
+		if (--*SkippedCount <= 0)
+		{
+			SkippedSpawns.Remove(Guid);
+		}
+		return;
+	}
+	if (AnimActorSys::FPendingLoad* PendingLoad = PendingLoads.Find(Guid); PendingLoad && PendingLoad->Pending > 0)
+	{
+		PendingLoad->Pending--;
+		PendingLoad->Cancelled++;
+		return;
+	}
+	ReleaseAnimActorUser(Guid);
+}
+
+void UAnimationActorSubsystem::ReleaseAnimActorUser(const FGuid& Guid)
+{
+	if (AnimActorSys::FAnimActorAdmission* Admission = Admissions.Find(Guid); Admission && --Admission->Users <= 0)
+	{
+		RemoveAdmission(Guid);
+	}
+	
+	// Cancelling a request that hasn't been spawned yet. Once all users cancelled, it never spawns at all.
+	const int32 PendingIndex = PendingSpawns.IndexOfByPredicate(
+		[&Guid](const AnimActorSys::FPendingSpawnRequest& Request) { return Request.Guid == Guid; });
+	if (PendingIndex != INDEX_NONE)
+	{
+		if (--PendingSpawns[PendingIndex].Count <= 0)
+		{
+			PendingSpawns.RemoveAt(PendingIndex, EAllowShrinking::No);
+		}
+		return;
+	}
+	
+	const AnimActorSys::FAnimActorHandle Handle = Registry.Find(Guid);
+	if (AnimActorSys::FAnimActorSlot* Slot = Registry.Resolve(Handle))
+	{
+		AnimActorSys::FActorCounter* ActorCounter = &Slot->Counter;
 		AActor* Actor = ActorCounter->RemoveSingle();
 		
 		if(!bool(*ActorCounter))
 		{
-			if(IsValid(Actor)) // Check bc maybe this actor has been destroyed already from an outside system.
+			// Pooled actors and components are expected to come back at full quality.
+			if (Slot->Significance != EAnimActorSignificance::Full)
 			{
-				Actor->Destroy();
+				ApplySignificance(Actor, Slot->Component.Get(), EAnimActorSignificance::Full, Slot->SignificanceRestoreState);
 			}
 			
-			SpawnedActors.Remove(Guid);
+			if (USkeletalMeshComponent* SkeletalComp = Cast<USkeletalMeshComponent>(Slot->Component.Get() ? Slot->Component.Get()
+				: IsValid(Actor) ? Actor->GetRootComponent() : nullptr))
+			{
+				LeaveSharedPoseGroup(SkeletalComp);
+			}
+
+			if (Slot->InstanceBatchIndex != INDEX_NONE)
+			{
+				RemoveAnimActorInstance(*Slot);
+			}
+			else if (UPrimitiveComponent* Component = Slot->Component.Get())
+			{
+				ReleaseAnimComponent(Component);
+			}
+			else if(IsValid(Actor)) // Check bc maybe this actor has been destroyed already from an outside system.
+			{
+				if (HasFrameBudgetLeft())
+				{
+					ReleaseOrDestroy(Actor);
+				}
+				else
+				{
+					// Hide right away, the notify has ended. The expensive part can wait for a frame with budget left.
+					Actor->SetActorHiddenInGame(true);
+					PendingReleases.Emplace(Actor);
+				}
+			}
+			
+			Registry.Remove(Handle);
 		}
 		else
 		{
-			UE_LOG(LogAnimActorSys, Display, TEXT("Requested destruction of AnimActor for Guid %s, but but it is still active %d times"), *Guid.ToString(), ActorCounter->GetCount())
+			UE_LOG(LogAnimActorSys, Verbose, TEXT("Requested destruction of AnimActor for Guid %s, but it is still active %d times"), *Guid.ToString(), ActorCounter->GetCount())
 		}
 	}
 	else
@@ -90,12 +2083,81 @@ void UAnimationActorSubsystem::DestroyAnimActor(const FGuid Guid)
 	}
 }
 
+void UAnimationActorSubsystem::StartNotifyCapture()
+{
+	if (NotifyCapture)
+	{
+		return;
+	}
+	NotifyCapture = MakeUnique<AnimActorSys::FNotifyCapture>();
+	NotifyCaptureFrame = 0;
+	UE_LOG(LogAnimActorSys, Log, TEXT("Started capturing spawn notify events."))
+}
+
+FString UAnimationActorSubsystem::StopNotifyCapture(const FString& FilePath)
+{
+	if (!NotifyCapture)
+	{
+		return FString();
+	}
+	const TUniquePtr<AnimActorSys::FNotifyCapture> Capture = MoveTemp(NotifyCapture);
+	if (Capture->GetEvents().IsEmpty())
+	{
+		UE_LOG(LogAnimActorSys, Log, TEXT("Stopped capturing spawn notify events. Nothing was recorded."))
+		return FString();
+	}
+
+	FString OutputPath = FilePath;
+	if (OutputPath.IsEmpty())
+	{
+		const FString MapName = UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName());
+		OutputPath = FPaths::ProjectSavedDir() / TEXT("AnimationActorSystem") / TEXT("Captures")
+			/ FPaths::MakeValidFileName(MapName.Replace(TEXT("/"), TEXT("_")), TEXT('_'))
+			+ TEXT("_") + FDateTime::Now().ToString() + TEXT(".aacap");
+	}
+
+	if (!Capture->Save(OutputPath))
+	{
+		UE_LOG(LogAnimActorSys, Error, TEXT("Failed to write the spawn notify capture to %s."), *OutputPath)
+		return FString();
+	}
+	UE_LOG(LogAnimActorSys, Log, TEXT("Wrote %d spawn notify events of %d notifies to %s."),
+	       Capture->GetEvents().Num(), Capture->GetStreams().Num(), *OutputPath)
+	return OutputPath;
+}
+
+void UAnimationActorSubsystem::RecordNotifyEvent(const AnimActorSys::ENotifyCaptureEvent Type,
+                                                 const UAnimNotifyState_SpawnActorBase* Notify,
+                                                 const USkeletalMeshComponent* MeshComp,
+                                                 const FAnimNotifyEventReference& EventReference, const float Value)
+{
+	if (!NotifyCapture)
+	{
+		return;
+	}
+	if (NotifyCaptureFrame != GFrameCounter)
+	{
+		NotifyCaptureFrame = GFrameCounter;
+		NotifyCapture->RecordFrame(GetWorld()->GetDeltaSeconds());
+	}
+	NotifyCapture->RecordEvent(Type, Notify, MeshComp, EventReference, Value);
+}
+
 void UAnimationActorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
 	Super::OnWorldBeginPlay(InWorld);
 
+	// The delegate may be broadcast from any thread, so only flag the trim here and handle it in the next Tick.
+	MemoryTrimDelegateHandle = FCoreDelegates::GetMemoryTrimDelegate().AddUObject(this, &UAnimationActorSubsystem::RequestMemoryTrim);
+
 	const UAnimationActorSystemSettings* Settings = UAnimationActorSystemSettings::Get();	
 	FStreamableManager& StreamableManager = UAssetManager::GetStreamableManager();
+
+	// Nothing to preload for servers that skip notifies, whatever they still spawn is loaded on first use.
+	if (InWorld.GetNetMode() == NM_DedicatedServer && Settings->DedicatedServerPolicy != EAnimActorServerPolicy::SpawnAll)
+	{
+		return;
+	}
 	
 	// Load SkeletalMeshActor Class if applicable
 	if (Settings->SkeletalMeshActorLoadingBehaviour == EAnimActorClassLoadingBehaviour::BeginPlay_Async)
@@ -103,13 +2165,14 @@ void UAnimationActorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 		StreamableManager.RequestAsyncLoad(Settings->SkeletalMeshActorClass.ToSoftObjectPath(),
 		                                   FStreamableDelegate::CreateWeakLambda(this, [this]
 		                                   {
-			                                   ReferencedAnimActorClasses.AddUnique(
-				                                   UAnimationActorSystemSettings::Get()->SkeletalMeshActorClass.Get());
+			                                   MarkClassReferenced(UAnimationActorSystemSettings::Get()->SkeletalMeshActorClass.Get());
+			                                   PrewarmPoolFromSettings(UAnimationActorSystemSettings::Get()->SkeletalMeshActorClass.Get());
 		                                   }));
 	}
 	else if (Settings->SkeletalMeshActorLoadingBehaviour == EAnimActorClassLoadingBehaviour::BeginPlay_Blocking)
 	{
-		ReferencedAnimActorClasses.AddUnique(Settings->SkeletalMeshActorClass.LoadSynchronous());
+		MarkClassReferenced(Settings->SkeletalMeshActorClass.LoadSynchronous());
+		PrewarmPoolFromSettings(Settings->SkeletalMeshActorClass.Get());
 	}
 
 	// Load StaticMeshActor Class  if applicable
@@ -118,14 +2181,66 @@ void UAnimationActorSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 		StreamableManager.RequestAsyncLoad(Settings->StaticMeshActorClass.ToSoftObjectPath(),
 		                                   FStreamableDelegate::CreateWeakLambda(this, [this]
 		                                   {
-			                                   ReferencedAnimActorClasses.AddUnique(
-			                                   	UAnimationActorSystemSettings::Get()->StaticMeshActorClass.Get());
+			                                   MarkClassReferenced(UAnimationActorSystemSettings::Get()->StaticMeshActorClass.Get());
+			                                   PrewarmPoolFromSettings(UAnimationActorSystemSettings::Get()->StaticMeshActorClass.Get());
 		                                   }));
 	}
 	else if (Settings->StaticMeshActorLoadingBehaviour == EAnimActorClassLoadingBehaviour::BeginPlay_Blocking)
 	{
-		ReferencedAnimActorClasses.AddUnique(Settings->StaticMeshActorClass.LoadSynchronous());
+		MarkClassReferenced(Settings->StaticMeshActorClass.LoadSynchronous());
+		PrewarmPoolFromSettings(Settings->StaticMeshActorClass.Get());
+	}
+
+	// Preload whatever had to be sync-loaded the last times this map was played.
+	if (Settings->bEnablePreloadCache && InWorld.IsGameWorld() && !IsRunningCommandlet())
+	{
+		PreloadCache.Load(UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName()));
+		TArray<FSoftObjectPath> PathsToPreload = PreloadCache.GetPathsToPreload();
+		if (!PathsToPreload.IsEmpty())
+		{
+			UE_LOG(LogAnimActorSys, Verbose, TEXT("Preloading %d assets from the preload cache."), PathsToPreload.Num())
+			PreloadCacheHandle = StreamableManager.RequestAsyncLoad(MoveTemp(PathsToPreload));
+		}
+	}
+
+	// Prewarm pools of explicitly configured classes. These have to be loaded for that anyway.
+	for (const auto& [PooledClass, PoolSettings] : Settings->PerClassPoolSettings)
+	{
+		if (!Settings->bEnableActorPooling || PoolSettings.PrewarmCount <= 0 || PooledClass.IsNull())
+		{
+			continue;
+		}
+		StreamableManager.RequestAsyncLoad(PooledClass.ToSoftObjectPath(),
+		                                   FStreamableDelegate::CreateWeakLambda(this, [this, PooledClass]
+		                                   {
+			                                   PrewarmPoolFromSettings(PooledClass.Get());
+		                                   }));
+	}
+}
+
+void UAnimationActorSubsystem::Deinitialize()
+{
+	for (const auto& [Guid, Entry] : LookaheadEntries)
+	{
+		if (Entry.StreamingHandle)
+		{
+			Entry.StreamingHandle->ReleaseHandle();
+		}
+	}
+	LookaheadEntries.Reset();
+
+	StopNotifyCapture();
+
+	FCoreDelegates::GetMemoryTrimDelegate().Remove(MemoryTrimDelegateHandle);
+	
+	PreloadCache.Save();
+	if (PreloadCacheHandle)
+	{
+		PreloadCacheHandle->ReleaseHandle();
+		PreloadCacheHandle.Reset();
 	}
+	
+	Super::Deinitialize();
 }
 
 UAnimationActorSubsystem* UAnimationActorSubsystem::Get(const UObject* WorldContext)
@@ -147,8 +2262,8 @@ UAnimationActorSubsystem* UAnimationActorSubsystem::Get(const UObject* WorldCont
 
 bool UAnimationActorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
 {
-	// This Subsystem is generally pretty lightweight, and it doesn't tick, so I'd rather have it be active, in case
-	// a notify needs it, rather than not.
+	// This Subsystem is generally pretty lightweight. It ticks every frame, but its queues, lookahead, significance and release checks
+	// are cheap while no notify uses it, so I'd rather have it be active, in case a notify needs it, rather than not.
 	// If not desired, the Notify should not fire instead of this not supporting a given world type.
 	return !(WorldType == EWorldType::Type::None
 		|| WorldType == EWorldType::Type::Editor);
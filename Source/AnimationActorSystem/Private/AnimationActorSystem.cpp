@@ -3,6 +3,68 @@
 
 #include "AnimationActorSystem.h"
 
+#include "AnimationActorSubsystem.h"
+#include "AnimNotifyState_SpawnActorBase.h"
+#include "Animation/AnimSequenceBase.h"
+#include "UObject/AssetRegistryTagsContext.h"
+
 DEFINE_LOG_CATEGORY(LogAnimActorSys)
+
+void FAnimationActorSystemModule::StartupModule()
+{
+#if WITH_EDITOR
+	ExtraObjectTagsHandle = UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.AddStatic(
+		&FAnimationActorSystemModule::AddSpawnDependencyTags);
+#endif
+}
+
+void FAnimationActorSystemModule::ShutdownModule()
+{
+#if WITH_EDITOR
+	UObject::FAssetRegistryTag::OnGetExtraObjectTagsWithContext.Remove(ExtraObjectTagsHandle);
+#endif
+}
+
+#if WITH_EDITOR
+void FAnimationActorSystemModule::AddSpawnDependencyTags(FAssetRegistryTagsContext Context)
+{
+	const UAnimSequenceBase* Animation = Cast<UAnimSequenceBase>(Context.GetObject());
+	if (!Animation)
+	{
+		return;
+	}
+
+	// Both variants are written, the subsystem picks one when reading them at runtime.
+	TArray<FSoftObjectPath> Dependencies;
+	TArray<FSoftObjectPath> FallbackDependencies;
+	for (const FAnimNotifyEvent& NotifyEvent : Animation->Notifies)
+	{
+		if (UAnimNotifyState_SpawnActorBase* SpawnNotify = Cast<UAnimNotifyState_SpawnActorBase>(NotifyEvent.NotifyStateClass))
+		{
+			SpawnNotify->GatherTaggedSpawnDependencies(Dependencies, FallbackDependencies);
+		}
+	}
+	AddDependencyTag(Context, UAnimationActorSubsystem::SpawnDependenciesAssetRegistryTag, Dependencies);
+	AddDependencyTag(Context, UAnimationActorSubsystem::SpawnFallbackDependenciesAssetRegistryTag, FallbackDependencies);
+}
+
+void FAnimationActorSystemModule::AddDependencyTag(FAssetRegistryTagsContext& Context, const FName Tag,
+                                                   TConstArrayView<FSoftObjectPath> Dependencies)
+{
+	TArray<FString> DependencyStrings;
+	for (const FSoftObjectPath& Dependency : Dependencies)
+	{
+		if (!Dependency.IsNull())
+		{
+			DependencyStrings.AddUnique(Dependency.ToString());
+		}
+	}
+	if (!DependencyStrings.IsEmpty())
+	{
+		Context.AddTag(UObject::FAssetRegistryTag(Tag, FString::Join(DependencyStrings, TEXT(";")),
+		                                          UObject::FAssetRegistryTag::TT_Hidden));
+	}
+}
+#endif
 	
 IMPLEMENT_MODULE(FAnimationActorSystemModule, AnimationActorSystem)
\ No newline at end of file
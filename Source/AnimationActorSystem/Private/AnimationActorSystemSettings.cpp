@@ -4,8 +4,111 @@
 #include "AnimationActorSystemSettings.h"
 
 #include "AnimationActorSystem.h"
+#include "AnimationActorPoolable.h"
+#include "HAL/IConsoleManager.h"
+#if WITH_EDITOR
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
+#endif
+
+static TAutoConsoleVariable<bool> CVarAnimActorSysEnabled(
+	TEXT("AnimActorSys.Enabled"),
+	true,
+	TEXT("Whether animation notifies of the AnimationActorSystem spawn anything. Already spawned AnimActors stay until their notify ends."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<int32> CVarAnimActorSysMaxLiveActors(
+	TEXT("AnimActorSys.MaxLiveActors"),
+	-1,
+	TEXT("Maximum amount of AnimActors alive per world. -1 uses MaxLiveAnimActors from the project settings, 0 is unlimited."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarAnimActorSysPoolSizeScale(
+	TEXT("AnimActorSys.PoolSizeScale"),
+	1.f,
+	TEXT("Scales the prewarm counts and maximum sizes of all AnimActor pools. Pools exceeding their new size are trimmed."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<float> CVarAnimActorSysTickInterval(
+	TEXT("AnimActorSys.TickInterval"),
+	0.f,
+	TEXT("Tick interval in seconds for spawned AnimActors and their components. 0 ticks every frame."),
+	ECVF_Scalability);
+
+static TAutoConsoleVariable<bool> CVarAnimActorSysSkeletalMeshFallback(
+	TEXT("AnimActorSys.SkeletalMeshFallback"),
+	false,
+	TEXT("Whether skeletal mesh notifies with a StaticMeshFallback spawn that instead of their animated skeletal mesh."),
+	ECVF_Scalability);
+
+bool UAnimationActorSystemSettings::IsClassPreloadedOnBeginPlay(const UClass* Class) const
+{
+	if (!Class)
+	{
+		return false;
+	}
+	auto IsLoadedOnBeginPlay = [](const EAnimActorClassLoadingBehaviour Behaviour)
+	{
+		return Behaviour == EAnimActorClassLoadingBehaviour::BeginPlay_Async || Behaviour == EAnimActorClassLoadingBehaviour::BeginPlay_Blocking;
+	};
+	if ((Class == SkeletalMeshActorClass.Get() && IsLoadedOnBeginPlay(SkeletalMeshActorLoadingBehaviour))
+		|| (Class == StaticMeshActorClass.Get() && IsLoadedOnBeginPlay(StaticMeshActorLoadingBehaviour)))
+	{
+		return true;
+	}
+	const FAnimActorPoolSettings* ClassSettings = PerClassPoolSettings.Find(TSoftClassPtr<AActor>(Class));
+	return bEnableActorPooling && ClassSettings && ClassSettings->PrewarmCount > 0;
+}
+
+FAnimActorPoolSettings UAnimationActorSystemSettings::GetPoolSettingsForClass(const UClass* Class) const
+{
+	if (!bEnableActorPooling || !Class)
+	{
+		return FAnimActorPoolSettings{0, 0};
+	}
+
+	FAnimActorPoolSettings PoolSettings = FAnimActorPoolSettings{0, 0};
+	if (const FAnimActorPoolSettings* ClassSettings = PerClassPoolSettings.Find(TSoftClassPtr<AActor>(Class)))
+	{
+		PoolSettings = *ClassSettings;
+	}
+	else if (Class == SkeletalMeshActorClass.Get() || Class == StaticMeshActorClass.Get()
+		|| Class->ImplementsInterface(UAnimationActorPoolable::StaticClass()))
+	{
+		PoolSettings = DefaultPoolSettings;
+	}
+
+	const float Scale = GetPoolSizeScale();
+	PoolSettings.PrewarmCount = FMath::RoundToInt32(PoolSettings.PrewarmCount * Scale);
+	PoolSettings.MaxPoolSize = FMath::RoundToInt32(PoolSettings.MaxPoolSize * Scale);
+	return PoolSettings;
+}
+
+bool UAnimationActorSystemSettings::IsSystemEnabled() const
+{
+	return CVarAnimActorSysEnabled.GetValueOnGameThread();
+}
+
+float UAnimationActorSystemSettings::GetPoolSizeScale() const
+{
+	return FMath::Max(CVarAnimActorSysPoolSizeScale.GetValueOnGameThread(), 0.f);
+}
+
+int32 UAnimationActorSystemSettings::GetMaxLiveAnimActors() const
+{
+	const int32 CVarValue = CVarAnimActorSysMaxLiveActors.GetValueOnGameThread();
+	return CVarValue >= 0 ? CVarValue : MaxLiveAnimActors;
+}
+
+float UAnimationActorSystemSettings::GetAnimActorTickInterval() const
+{
+	return FMath::Max(CVarAnimActorSysTickInterval.GetValueOnGameThread(), 0.f);
+}
+
+bool UAnimationActorSystemSettings::ShouldUseSkeletalMeshFallback() const
+{
+	return CVarAnimActorSysSkeletalMeshFallback.GetValueOnGameThread();
+}
 
 #if WITH_EDITOR	
 void UAnimationActorSystemSettings::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
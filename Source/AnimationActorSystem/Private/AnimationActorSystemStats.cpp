@@ -0,0 +1,80 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorSystemStats.h"
+
+#include "Trace/Trace.inl"
+
+DEFINE_STAT(STAT_AnimActorSys_Tick);
+DEFINE_STAT(STAT_AnimActorSys_SpawnAnimActor);
+DEFINE_STAT(STAT_AnimActorSys_PostSpawnActor);
+DEFINE_STAT(STAT_AnimActorSys_DestroyAnimActor);
+DEFINE_STAT(STAT_AnimActorSys_NotifyTickSync);
+DEFINE_STAT(STAT_AnimActorSys_ClassLoadWait);
+DEFINE_STAT(STAT_AnimActorSys_LiveAnimActors);
+DEFINE_STAT(STAT_AnimActorSys_PoolHits);
+DEFINE_STAT(STAT_AnimActorSys_PoolMisses);
+DEFINE_STAT(STAT_AnimActorSys_PoolHitRate);
+
+CSV_DEFINE_CATEGORY(AnimActorSys, true);
+
+UE_TRACE_CHANNEL_DEFINE(AnimActorSysChannel);
+
+UE_TRACE_EVENT_BEGIN(AnimActorSys, NotifyEvent)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint32, GuidA)
+	UE_TRACE_EVENT_FIELD(uint32, GuidB)
+	UE_TRACE_EVENT_FIELD(uint32, GuidC)
+	UE_TRACE_EVENT_FIELD(uint32, GuidD)
+	UE_TRACE_EVENT_FIELD(uint8, Event)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(AnimActorSys, LiveCount)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(int32, Count)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, ClassName)
+UE_TRACE_EVENT_END()
+
+namespace AnimActorSys
+{
+	void TraceEvent(const ETraceEvent Event, const FGuid& Guid, const uint64 StartCycle, const uint64 EndCycle)
+	{
+		UE_TRACE_LOG(AnimActorSys, NotifyEvent, AnimActorSysChannel)
+			<< NotifyEvent.StartCycle(StartCycle)
+			<< NotifyEvent.EndCycle(EndCycle)
+			<< NotifyEvent.GuidA(Guid.A)
+			<< NotifyEvent.GuidB(Guid.B)
+			<< NotifyEvent.GuidC(Guid.C)
+			<< NotifyEvent.GuidD(Guid.D)
+			<< NotifyEvent.Event(static_cast<uint8>(Event));
+	}
+
+	void TraceLiveCount(const FName& ClassName, const int32 Count)
+	{
+		UE_TRACE_LOG(AnimActorSys, LiveCount, AnimActorSysChannel)
+			<< LiveCount.Cycle(FPlatformTime::Cycles64())
+			<< LiveCount.Count(Count)
+			<< LiveCount.ClassName(*ClassName.ToString());
+	}
+
+	bool ShouldReportLiveCounts()
+	{
+#if CSV_PROFILER
+		if (FCsvProfiler::Get()->IsCapturing())
+		{
+			return true;
+		}
+#endif
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(AnimActorSysChannel);
+	}
+
+	void RecordClassLoadWait(const FGuid& Guid, const uint64 StartCycle)
+	{
+		const uint64 EndCycle = FPlatformTime::Cycles64();
+		const float WaitMs = static_cast<float>(FPlatformTime::ToMilliseconds64(EndCycle - StartCycle));
+		INC_FLOAT_STAT_BY(STAT_AnimActorSys_ClassLoadWait, WaitMs);
+		CSV_CUSTOM_STAT(AnimActorSys, ClassLoadWaitMs, WaitMs, ECsvCustomStatOp::Accumulate);
+		TraceEvent(ETraceEvent::ClassLoadWait, Guid, StartCycle, EndCycle);
+	}
+}
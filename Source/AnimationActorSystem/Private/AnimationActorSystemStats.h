@@ -0,0 +1,73 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+DECLARE_STATS_GROUP(TEXT("AnimationActorSystem"), STATGROUP_AnimActorSys, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Subsystem Tick"), STAT_AnimActorSys_Tick, STATGROUP_AnimActorSys, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SpawnAnimActor"), STAT_AnimActorSys_SpawnAnimActor, STATGROUP_AnimActorSys, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PostSpawnActor"), STAT_AnimActorSys_PostSpawnActor, STATGROUP_AnimActorSys, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("DestroyAnimActor"), STAT_AnimActorSys_DestroyAnimActor, STATGROUP_AnimActorSys, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Animation Sync"), STAT_AnimActorSys_NotifyTickSync, STATGROUP_AnimActorSys, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Class Load Wait (ms)"), STAT_AnimActorSys_ClassLoadWait, STATGROUP_AnimActorSys, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live AnimActors"), STAT_AnimActorSys_LiveAnimActors, STATGROUP_AnimActorSys, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Hits"), STAT_AnimActorSys_PoolHits, STATGROUP_AnimActorSys, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pool Misses"), STAT_AnimActorSys_PoolMisses, STATGROUP_AnimActorSys, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Pool Hit Rate (%)"), STAT_AnimActorSys_PoolHitRate, STATGROUP_AnimActorSys, );
+
+CSV_DECLARE_CATEGORY_EXTERN(AnimActorSys);
+
+UE_TRACE_CHANNEL_EXTERN(AnimActorSysChannel);
+
+namespace AnimActorSys
+{
+	/** What an event on the AnimActorSysChannel measured. */
+	enum class ETraceEvent : uint8
+	{
+		ClassLoadWait,
+		SpawnAnimActor,
+		PostSpawnActor,
+		DestroyAnimActor,
+		NotifyTickSync,
+	};
+
+	/** Emits an event with the notify Guid on the AnimActorSysChannel, so single notifies can be followed in Unreal Insights. */
+	void TraceEvent(ETraceEvent Event, const FGuid& Guid, uint64 StartCycle, uint64 EndCycle);
+
+	/** Emits the amount of live AnimActors of a class on the AnimActorSysChannel. */
+	void TraceLiveCount(const FName& ClassName, int32 Count);
+
+	/** Whether anybody is listening for the per-class live counts, which are not free to gather. */
+	[[nodiscard]] bool ShouldReportLiveCounts();
+
+	/** Records the time a notify waited for its class and assets to load, from StartCycle until now. */
+	void RecordClassLoadWait(const FGuid& Guid, uint64 StartCycle);
+
+	/** Traces the enclosing scope with the notify Guid. */
+	struct FScopedTraceEvent
+	{
+		FScopedTraceEvent(const ETraceEvent InEvent, const FGuid& InGuid)
+			: Event(InEvent), Guid(InGuid), StartCycle(FPlatformTime::Cycles64())
+		{}
+
+		~FScopedTraceEvent()
+			{ TraceEvent(Event, Guid, StartCycle, FPlatformTime::Cycles64()); }
+
+	private:
+		ETraceEvent Event;
+		FGuid Guid;
+		uint64 StartCycle;
+	};
+}
+
+/** Measures the enclosing scope as stat, CSV timing and Guid-tagged trace event of the same Name. */
+#define ANIMACTORSYS_SCOPE(Name, Guid) \
+	SCOPE_CYCLE_COUNTER(STAT_AnimActorSys_##Name); \
+	CSV_SCOPED_TIMING_STAT(AnimActorSys, Name); \
+	const AnimActorSys::FScopedTraceEvent ANONYMOUS_VARIABLE(AnimActorSysTraceEvent_)(AnimActorSys::ETraceEvent::Name, Guid)
@@ -20,6 +20,7 @@ class USkeletalMeshComponent;
  * => GetSpawnableClassToLoad()
  * => Load actor class
  * => Let UAnimationActorSubsystem spawn the actor
+ * => PreSpawnActor(), before the actor's components are registered
  * => PostSpawnActor()
  */
 UCLASS(Abstract)
@@ -45,19 +46,93 @@ public:
 	/** Transform to apply relative to AttachBone, if specified */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
 	FTransform AttachTransform = FTransform::Identity;
+
+	/** If the subsystem's frame budget is exceeded, spawns with higher priority are processed first.
+	 * Once a concurrency cap is reached, lower priority AnimActors are evicted first. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category="AnimActor")
+	int32 SpawnPriority = 0;
+
+	/** Whether the spawn may be reduced in quality or skipped when its owner is insignificant to the viewer.
+	 * Disable for anything gameplay relies on. See UAnimationActorSystemSettings::bEnableSignificance. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category="AnimActor")
+	bool bAllowSignificanceCulling = true;
+
+	/** Whether the spawn is purely visual. Cosmetic notifies do nothing at all on dedicated servers,
+	 * see UAnimationActorSystemSettings::DedicatedServerPolicy. Disable for anything the server's gameplay relies on. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category="AnimActor")
+	bool bCosmetic = true;
+
+	/** Features to switch off on the spawned actor or component. Props that are only looked at need none of them. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category="AnimActor")
+	FAnimActorSpawnProfile SpawnProfile;
 	
 	virtual TSoftClassPtr<AActor> GetSpawnableClassToLoad() { return nullptr; };
 
 	virtual EAnimActorClassLoadingBehaviour GetLoadingBehaviour()
 		{ return EAnimActorClassLoadingBehaviour::FirstTimeRequested_Blocking; }
 
+	/** Add any assets the spawn needs besides the actor class (meshes, animations, ...).
+	 * They are loaded together with the class, following GetLoadingBehaviour(). */
+	virtual void GatherAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const {}
+
+	/** Everything this notify needs loaded to spawn: the actor class and GatherAssetsToLoad().
+	 * Also written to the asset registry tags of the owning animation, see UAnimationActorSubsystem::PreloadAnimationDependencies(). */
+	void GatherSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies);
+
+	/** The spawn dependencies with and without the skeletal mesh fallback, no matter whether AnimActorSys.SkeletalMeshFallback is enabled right now.
+	 * Used for the asset registry tags, which must not depend on the settings of whoever saved the animation.
+	 * Baseclass version has no fallback, so both are the GatherSpawnDependencies(). */
+	virtual void GatherTaggedSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies, TArray<FSoftObjectPath>& OutFallbackDependencies);
+
+	/** Lets subclasses represent the spawn by something other than an actor, e.g. an instance of an instanced static mesh.
+	 * Called instead of spawning an actor once everything is loaded. The representation has to be registered with the
+	 * Subsystem under Guid, so it gets removed by NotifyEnd. If that fails, call UAnimationActorSubsystem::CancelAnimActor() instead.
+	 * @return true if handled, false to spawn the actor as usual. */
+	virtual bool SpawnWithoutActor(UAnimationActorSubsystem* Subsystem, USkeletalMeshComponent* MeshComp, const FGuid& Guid,
+	                               const FAnimNotifyEventReference& EventReference)
+		{ return false; }
+
+	/** Configures the Actor before its components are registered, so mesh, mobility, collision and so on are set up only once.
+	 * Pooled and pre-spawned actors are registered already and get passed in right after they're taken instead.
+	 * Only configure the actor itself here, attaching and everything depending on its registered state belongs into PostSpawnActor().
+	 * Baseclass version makes the root movable, so don't forget the super:: call. */
+	virtual void PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp, const FAnimNotifyEventReference& EventReference);
+
+	/** Applies the SpawnProfile to the actor and all of its primitive components. Called right after PreSpawnActor(). */
+	void ApplySpawnProfile(AActor* Actor) const;
+
+	/** Applies the SpawnProfile to a single component. Component spawns have to call this after configuring the component. */
+	void ApplySpawnProfile(UPrimitiveComponent* Component) const;
+
+	/** Whether Component has to keep ticking for the spawn to work, even if the SpawnProfile disables tick.
+	 * Baseclass version keeps skinned meshes ticking, since they animate in their tick. */
+	virtual bool NeedsComponentTick(const UPrimitiveComponent* Component) const;
+
 	/** Executed after the Actor is spawned and registered with the subsystem.
 	 * Baseclass version already handles attachment, so don't forget the super:: call or do it yourself. */
 	virtual void PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
 	                            USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
 	                            const FAnimNotifyEventReference& EventReference);
 	
+	/** The asset the per-mesh concurrency caps of this notify apply to. */
+	virtual const UObject* GetConcurrencyAsset() const
+		{ return nullptr; }
+
+	/** Whether this notify does nothing when fired by MeshComp, because its world is a dedicated server that skips it. */
+	bool IsSkippedOnServer(const USkeletalMeshComponent* MeshComp) const;
+
+	/** Whether the notify spawns an actor via the subsystem, or is handled by SpawnWithoutActor(). */
+	virtual bool SpawnsActor() const
+		{ return true; }
+
+	/** Constructs a deterministic FGuid from the StaticPartialAnimActorGuid and the object key of the InComponent.
+	 * Using this instead of just the StaticPartialAnimActorGuid automatically differentiates between
+	 * this notify being fired from the same animation but on different actors/components.
+	 */
+	FGuid ConstructDeterministicGuidFromComponent(USkeletalMeshComponent* InComponent) const;
+
 	FString BuildNotifyNameFromObject(UObject* Object) const;
+	FString BuildNotifyNameFromPath(const FSoftObjectPath& Path) const;
 
 	/** Get the Guid the actor spawned by this notify will be identified by. */
 	UFUNCTION(BlueprintPure, Category="AnimActor")
@@ -67,6 +142,8 @@ public:
 #pragma region UAnimNotifyState Interface
 	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
 							 const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float FrameDeltaTime,
+							const FAnimNotifyEventReference& EventReference) override;
 	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
 						   const FAnimNotifyEventReference& EventReference) override;
 #if WITH_EDITOR
@@ -91,11 +168,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, AdvancedDisplay, meta=(DisplayPriority=100), Category="AnimActor")
 	FGuid StaticPartialAnimActorGuid = FGuid();
 
-	/** Constructs a deterministic FGuid from the StaticPartialAnimActorGuid and the object path of the InComponent.
-	 * Using this instead of just the StaticPartialAnimActorGuid automatically differentiates between
-	 * this notify being fired from the same animation but on different actors/components.
-	 */
-	FGuid ConstructDeterministicGuidFromComponent(USkeletalMeshComponent* InComponent) const;
+	FString BuildNotifyNameFromObjectName(const FString& ObjectName) const;
+
+	/** The bone or socket to attach to, taking mirroring of the notify into account. */
+	FName ResolveAttachBone(const FAnimNotifyEventReference& EventReference) const;
 
 private:
 #if WITH_EDITORONLY_DATA
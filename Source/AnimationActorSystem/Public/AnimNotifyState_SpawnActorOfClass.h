@@ -10,6 +10,7 @@
 
 /**
  * Spawn an actor of a given class on NotifyBegin and destroy it when the notify ends.
+ * Implement IAnimationActorPoolable on the class (or list it in the pool settings) to have it reused instead.
  */
 UCLASS(DisplayName="Timed Spawn Actor of Class")
 class ANIMATIONACTORSYSTEM_API UAnimNotifyState_SpawnActorOfClass : public UAnimNotifyState_SpawnActorBase
@@ -22,6 +23,8 @@ public:
 #if WITH_EDITORONLY_DATA
 		NotifyColor = FColor::Magenta;
 #endif
+		// Arbitrary actors may well matter to gameplay.
+		bCosmetic = false;
 	}
 		
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
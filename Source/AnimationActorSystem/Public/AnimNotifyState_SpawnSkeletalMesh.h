@@ -13,6 +13,8 @@
 #include "AnimNotifyState_SpawnSkeletalMesh.generated.h"
 
 class UAnimSequenceBase;
+class UStaticMesh;
+class UStaticMeshComponent;
 
 /**
  * Spawn a SkeletalMesh on NotifyBegin and destroy it when the notify ends.
@@ -30,10 +32,15 @@ public:
 #endif
 	}
 
-	/** The skeletal mesh to spawn for the duration of this notify */
+	/** The skeletal mesh to spawn for the duration of this notify.
+	 * Loaded together with the actor class, following the SkeletalMeshActorLoadingBehaviour. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
-	TObjectPtr<USkeletalMesh> MeshToSpawn = nullptr;
+	TSoftObjectPtr<USkeletalMesh> MeshToSpawn = nullptr;
 	
+	/** Whether to spawn an actor per notify, or to add a component to the owning actor. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	EAnimActorSkeletalMeshSpawnMode SpawnMode = EAnimActorSkeletalMeshSpawnMode::Actor;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
 	EAnimActorAnimationMode AnimationMode = EAnimActorAnimationMode::AnimSequence;
 
@@ -41,7 +48,7 @@ public:
 	/** The animation that should play on the notifies spawned skeletal mesh */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor", meta=(EditConditionHides,
 		EditCondition="AnimationMode == EAnimActorAnimationMode::AnimSequence"))
-	TObjectPtr<UAnimSequenceBase> AnimationToPlay = nullptr;
+	TSoftObjectPtr<UAnimSequenceBase> AnimationToPlay = nullptr;
 
 	/** Whether to specify a loop behaviour for the animation.
 	 * If false, will use the loop setting from the animation.*/
@@ -59,7 +66,7 @@ public:
 	/** The animation that should play on the notifies spawned skeletal mesh */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor", meta=(EditConditionHides,
 		EditCondition="AnimationMode == EAnimActorAnimationMode::AnimBlueprint"))
-	TSubclassOf<UAnimInstance> AnimationBlueprint = nullptr;
+	TSoftClassPtr<UAnimInstance> AnimationBlueprint = nullptr;
 #pragma endregion
 
 	/** Whether to override the skeletal mesh's collision profile */
@@ -70,13 +77,39 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bOverrideCollisionProfile", EditConditionHides), Category="AnimActor")
 	FCollisionProfileName CollisionProfileOverride = FCollisionProfileName();
 
+	/** Static mesh to spawn instead while AnimActorSys.SkeletalMeshFallback is enabled, e.g. by a low-end device profile.
+	 * It doesn't animate, so pick something that reads well in a single pose. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, AdvancedDisplay, Category="AnimActor")
+	TSoftObjectPtr<UStaticMesh> StaticMeshFallback = nullptr;
+
+	/** Whether the StaticMeshFallback is spawned instead of the skeletal mesh right now. */
+	bool ShouldUseStaticMeshFallback() const
+		{ return !StaticMeshFallback.IsNull() && UAnimationActorSystemSettings::Get()->ShouldUseSkeletalMeshFallback(); }
+
 #pragma region UAnimNotifyState_SpawnActorBase Interface
 	virtual TSoftClassPtr<AActor> GetSpawnableClassToLoad() override
-		{ return UAnimationActorSystemSettings::Get()->SkeletalMeshActorClass; };
+		{ return GetSpawnableClass(ShouldUseStaticMeshFallback()); };
 	
 	virtual EAnimActorClassLoadingBehaviour GetLoadingBehaviour() override
 		{ return UAnimationActorSystemSettings::Get()->SkeletalMeshActorLoadingBehaviour; };
 
+	virtual void GatherAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const override
+		{ GatherMeshAssets(OutAssets, ShouldUseStaticMeshFallback()); }
+
+	virtual void GatherTaggedSpawnDependencies(TArray<FSoftObjectPath>& OutDependencies, TArray<FSoftObjectPath>& OutFallbackDependencies) override;
+
+	virtual const UObject* GetConcurrencyAsset() const override;
+
+	virtual bool SpawnsActor() const override
+		{ return SpawnMode == EAnimActorSkeletalMeshSpawnMode::Actor; }
+
+	virtual bool SpawnWithoutActor(UAnimationActorSubsystem* Subsystem, USkeletalMeshComponent* MeshComp, const FGuid& Guid,
+	                               const FAnimNotifyEventReference& EventReference) override;
+
+	virtual void PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp, const FAnimNotifyEventReference& EventReference) override;
+
+	virtual bool NeedsComponentTick(const UPrimitiveComponent* Component) const override;
+
 	virtual void PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
 	                            USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
 	                            const FAnimNotifyEventReference& EventReference) override;
@@ -84,8 +117,23 @@ public:
 
 #pragma region UAnimNotifyState Interface
 	virtual FString GetNotifyName_Implementation() const override;
-
-	virtual void NotifyTick(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation,
-		float FrameDeltaTime, const FAnimNotifyEventReference& EventReference) override;
 #pragma endregion
+
+protected:
+	/** Applies mesh, collision and navigation settings to the spawned component, regardless of whether it is owned by an AnimActor.
+	 * Meant to be called before the component is registered. */
+	void ConfigureMeshComponent(USkeletalMeshComponent* Comp) const;
+
+	/** Sets up the AnimationMode on the spawned, registered component, following MeshComp if needed. */
+	void ConfigureAnimation(USkeletalMeshComponent* Comp, USkeletalMeshComponent* MeshComp) const;
+
+	/** Applies the StaticMeshFallback, collision and navigation settings to a spawned static mesh component. */
+	void ConfigureFallbackComponent(UStaticMeshComponent* Comp) const;
+
+private:
+	/** The actor class spawned with or without the StaticMeshFallback. */
+	TSoftClassPtr<AActor> GetSpawnableClass(bool bFallback) const;
+
+	/** The assets loaded with or without the StaticMeshFallback. */
+	void GatherMeshAssets(TArray<FSoftObjectPath>& OutAssets, bool bFallback) const;
 };
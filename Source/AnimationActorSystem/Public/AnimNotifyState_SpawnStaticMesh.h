@@ -28,31 +28,53 @@ public:
 #endif
 	}
 
-	/** The static mesh to spawn for the duration of this notify */
+	/** The static mesh to spawn for the duration of this notify.
+	 * Loaded together with the actor class, following the StaticMeshActorLoadingBehaviour. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
-	TObjectPtr<UStaticMesh> MeshToSpawn = nullptr;
+	TSoftObjectPtr<UStaticMesh> MeshToSpawn = nullptr;
 
-	/** Whether to override the static mesh's collision profile */
+	/** Whether to spawn an actor per notify, to add a component to the owning actor,
+	 * or to batch all notifies spawning the same mesh into one instanced static mesh.
+	 * Instanced meshes are much cheaper in large numbers, but have no collision.
+	 * Animation editor previews don't update instances, so they add a component instead. */
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	EAnimActorStaticMeshSpawnMode SpawnMode = EAnimActorStaticMeshSpawnMode::Actor;
+
+	/** Whether to override the static mesh's collision profile */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(EditCondition="SpawnMode != EAnimActorStaticMeshSpawnMode::Instanced"), Category="AnimActor")
 	bool bOverrideCollisionProfile = false;
 
 	/** Override for the static mesh's collision profile */
-	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bOverrideCollisionProfile"), Category="AnimActor")
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bOverrideCollisionProfile && SpawnMode != EAnimActorStaticMeshSpawnMode::Instanced"), Category="AnimActor")
 	FCollisionProfileName CollisionProfileOverride = FCollisionProfileName();
 
 #pragma region UAnimNotifyState_SpawnActorBase Interface
 	virtual TSoftClassPtr<AActor> GetSpawnableClassToLoad() override
-		{ return AStaticMeshActor::StaticClass();	};
+		{ return TSoftClassPtr<AActor>(UAnimationActorSystemSettings::Get()->StaticMeshActorClass.ToSoftObjectPath()); };
 	
 	virtual EAnimActorClassLoadingBehaviour GetLoadingBehaviour() override
 		{ return UAnimationActorSystemSettings::Get()->StaticMeshActorLoadingBehaviour; };
 
-	virtual void PostSpawnActor(AActor* SpawnedActor, UAnimationActorSubsystem* Subsystem,
-	                            USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration,
-	                            const FAnimNotifyEventReference& EventReference) override;
+	virtual void GatherAssetsToLoad(TArray<FSoftObjectPath>& OutAssets) const override
+		{ OutAssets.Add(MeshToSpawn.ToSoftObjectPath()); }
+
+	virtual const UObject* GetConcurrencyAsset() const override
+		{ return MeshToSpawn.Get(); }
+
+	virtual bool SpawnsActor() const override
+		{ return SpawnMode == EAnimActorStaticMeshSpawnMode::Actor; }
+
+	virtual bool SpawnWithoutActor(UAnimationActorSubsystem* Subsystem, USkeletalMeshComponent* MeshComp, const FGuid& Guid,
+	                               const FAnimNotifyEventReference& EventReference) override;
+
+	virtual void PreSpawnActor(AActor* Actor, USkeletalMeshComponent* MeshComp, const FAnimNotifyEventReference& EventReference) override;
 #pragma endregion UAnimNotifyState_SpawnActorBase Interface
 
 #pragma region UAnimNotifyState Interface
 	virtual FString GetNotifyName_Implementation() const override;
 #pragma endregion
+
+protected:
+	/** Applies mesh, collision and navigation settings to the spawned component, regardless of whether it is owned by an AnimActor. */
+	void ConfigureMeshComponent(UStaticMeshComponent* Comp) const;
 };
@@ -0,0 +1,71 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimSingleNodeInstance.h"
+#include "Animation/AnimSingleNodeInstanceProxy.h"
+#include "AnimationActorAnimInstance.generated.h"
+
+class UAnimNotifyState;
+
+/**
+ * Moves the single node playback to the time the owner's notify state is at, on the animation worker threads.
+ * Instead of setting the time directly, the play rate is picked to arrive there within the frame's delta time,
+ * so notifies of the played animation still fire.
+ */
+struct FAnimationActorAnimInstanceProxy : public FAnimSingleNodeInstanceProxy
+{
+	FAnimationActorAnimInstanceProxy() = default;
+	explicit FAnimationActorAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimSingleNodeInstanceProxy(InAnimInstance)
+	{}
+
+	virtual void UpdateAnimationNode(const FAnimationUpdateContext& InContext) override;
+
+private:
+	friend class UAnimationActorAnimInstance;
+
+	/** Written on the game thread before the update. */
+	float SyncTime = 0.f;
+	float PreviousSyncTime = 0.f;
+	bool bHasSyncTime = false;
+
+	float AnimLength = 0.f;
+	float AnimRateScale = 1.f;
+};
+
+/**
+ * Anim instance of skeletal meshes spawned in EAnimActorAnimationMode::AnimSequence.
+ * Plays the animation in sync with the notify state that spawned the mesh, which replaces syncing in NotifyTick.
+ * Only the owner's notify time is read on the game thread, right before the parallel update.
+ */
+UCLASS(Transient, NotBlueprintable)
+class ANIMATIONACTORSYSTEM_API UAnimationActorAnimInstance : public UAnimSingleNodeInstance
+{
+	GENERATED_BODY()
+
+public:
+	/** Plays Animation following the time of Notify on SyncSource. Assumes Animation is already set as the played asset. */
+	void InitSync(USkeletalMeshComponent* SyncSource, const UAnimNotifyState* Notify);
+
+	/** Stops following the SyncSource, e.g. when the mesh is released to a pool. */
+	void ClearSync()
+		{ InitSync(nullptr, nullptr); }
+
+	/** Time elapsed since the notify began on the SyncSource, false if it isn't active there. */
+	bool GetNotifyStateTime(float& OutTime) const;
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override
+		{ return new FAnimationActorAnimInstanceProxy(this); }
+
+	virtual void PreUpdateAnimation(float DeltaSeconds) override;
+
+private:
+	TWeakObjectPtr<USkeletalMeshComponent> SyncSource;
+
+	UPROPERTY(Transient)
+	TObjectPtr<const UAnimNotifyState> SyncNotify = nullptr;
+};
@@ -0,0 +1,65 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "AnimationActorTypes.h"
+#include "AnimationActorCopyPoseAnimInstance.generated.h"
+
+/**
+ * Builds the pose from the component space transforms of the source mesh, mapped by bone name.
+ * Bones the source doesn't have stay in their reference pose relative to their parent.
+ */
+struct FAnimationActorCopyPoseProxy : public FAnimInstanceProxy
+{
+	FAnimationActorCopyPoseProxy() = default;
+	explicit FAnimationActorCopyPoseProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{}
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+	virtual bool Evaluate(FPoseContext& Output) override;
+
+private:
+	friend class UAnimationActorCopyPoseAnimInstance;
+
+	TSharedPtr<const AnimActorSys::FBoneIndexMap> BoneIndexMap;
+
+	/** Copied from the source on the game thread. */
+	TArray<FTransform> SourceTransforms;
+};
+
+/**
+ * Anim instance of skeletal meshes spawned in EAnimActorAnimationMode::CopyPose.
+ * Follows the pose of the mesh that spawned it like a leader pose would, but works across skeletons.
+ */
+UCLASS(Transient, NotBlueprintable)
+class ANIMATIONACTORSYSTEM_API UAnimationActorCopyPoseAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	void SetSource(USkeletalMeshComponent* InSource);
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override
+		{ return new FAnimationActorCopyPoseProxy(this); }
+
+private:
+	friend struct FAnimationActorCopyPoseProxy;
+
+	/** The component whose pose is copied. Followers of a leader pose copy from their leader, which actually has the pose. */
+	USkeletalMeshComponent* GetPoseSource() const;
+
+	/** Requests the bone index map for Proxy if the source or our mesh changed. */
+	void UpdateBoneIndexMap(FAnimationActorCopyPoseProxy& Proxy);
+
+	TWeakObjectPtr<USkeletalMeshComponent> Source;
+
+	/** The meshes the current bone index map is for. */
+	FObjectKey MappedSourceMesh;
+	FObjectKey MappedTargetMesh;
+};
@@ -0,0 +1,91 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/ResourceSize.h"
+
+class UObject;
+
+namespace AnimActorSys
+{
+	/** What a row of the FMemoryReport is about. */
+	enum class EMemoryReportCategory : uint8
+	{
+		/** Actors, components and instances registered for active notifies. */
+		Live,
+		/** Inactive actors and components waiting to be reused. */
+		Pooled,
+		/** Actors hidden and waiting to be released, or pre-spawned by the lookahead. */
+		Lingering,
+		/** Actor classes kept from being garbage collected. */
+		ReferencedClass,
+		/** Meshes, animations, ... kept loaded for notifies. */
+		ReferencedAsset,
+	};
+
+	enum class EMemoryReportSortBy : uint8
+	{
+		TotalBytes,
+		CpuBytes,
+		GpuBytes,
+		Count,
+		Age,
+		Name,
+	};
+
+	/** Objects of one category, class and asset, summed up. */
+	struct FMemoryReportRow
+	{
+		EMemoryReportCategory Category = EMemoryReportCategory::Live;
+		FString Class;
+
+		/** The mesh of live and pooled objects, the asset itself for referenced assets. */
+		FString Asset;
+
+		int32 Count = 0;
+
+		/** Estimated resource sizes, see UObject::GetResourceSizeEx(). Meshes are only counted by their ReferencedAsset row. */
+		int64 CpuBytes = 0;
+		int64 GpuBytes = 0;
+
+		/** Seconds since the most recent use, or a negative value if it isn't tracked for this row. */
+		double LastUsedSecondsAgo = -1.0;
+	};
+
+	/**
+	 * Everything the UAnimationActorSubsystem of a world holds onto, with estimated sizes.
+	 * Gathered by UAnimationActorSubsystem::GatherMemoryReport(), or dumped via AnimActorSys.MemReport.
+	 */
+	struct ANIMATIONACTORSYSTEM_API FMemoryReport
+	{
+		FString World;
+		TArray<FMemoryReportRow> Rows;
+
+		/** The row of Category, ClassName and AssetName, added empty if it doesn't exist yet. */
+		FMemoryReportRow& FindOrAddRow(EMemoryReportCategory Category, const FString& ClassName, const FString& AssetName);
+
+		/** Counts Object in the row of Category, ClassName and AssetName, measuring its resource size. */
+		void Add(EMemoryReportCategory Category, const UObject* Object, const FString& ClassName, const FString& AssetName,
+		         double LastUsedSecondsAgo = -1.0, EResourceSizeMode::Type SizeMode = EResourceSizeMode::Exclusive);
+
+		/** Adds the resource size of Object to Row, without counting it. */
+		static void AddResourceSize(FMemoryReportRow& Row, const UObject* Object, EResourceSizeMode::Type SizeMode = EResourceSizeMode::Exclusive);
+
+		/** Sorts descending, except for Name. */
+		void Sort(EMemoryReportSortBy SortBy);
+
+		[[nodiscard]] int64 GetTotalBytes(EMemoryReportCategory Category) const;
+
+		void Log(FOutputDevice& Ar) const;
+		[[nodiscard]] bool SaveCsv(const FString& FilePath) const;
+
+		static const TCHAR* LexCategory(EMemoryReportCategory Category);
+		static bool ParseSortBy(const FString& String, EMemoryReportSortBy& OutSortBy);
+
+	private:
+		/** Row index per category, class and asset, only used while gathering. */
+		TMap<FString, int32> RowIndices;
+	};
+}
@@ -0,0 +1,81 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPath.h"
+
+struct FAnimNotifyEventReference;
+class UAnimNotifyState_SpawnActorBase;
+class USkeletalMeshComponent;
+
+namespace AnimActorSys
+{
+	enum class ENotifyCaptureEvent : uint8
+	{
+		/** A new frame started. Value is its delta time. */
+		Frame,
+		/** Value is the notify's TotalDuration. */
+		Begin,
+		/** Value is the FrameDeltaTime. */
+		Tick,
+		End,
+	};
+
+	/** A notify fired by one component with one mirror state. All events of it share this, so they stay small. */
+	struct FCapturedNotifyStream
+	{
+		/** The Guid the notify spawned its AnimActor with. */
+		FGuid Guid;
+
+		/** The notify object, an instanced subobject of the animation it's placed in. */
+		FSoftObjectPath Notify;
+
+		/** The actor class the notify spawned. */
+		FSoftObjectPath SpawnableClass;
+
+		/** Set if the notify was mirrored. */
+		FSoftObjectPath MirrorTable;
+
+		/** Identifies the component within the capture. Streams with the same key were fired by the same component. */
+		int32 ComponentKey = INDEX_NONE;
+	};
+
+	struct FCapturedNotifyEvent
+	{
+		ENotifyCaptureEvent Type = ENotifyCaptureEvent::Frame;
+		int32 StreamIndex = INDEX_NONE;
+		float Value = 0.f;
+	};
+
+	/**
+	 * Recording of all Begin/Tick/End calls of the spawn notifies in a world, to replay real sessions headlessly.
+	 * Stored as a compact binary file, see Save() and Load().
+	 */
+	class ANIMATIONACTORSYSTEM_API FNotifyCapture
+	{
+	public:
+		void RecordFrame(float DeltaTime);
+		void RecordEvent(ENotifyCaptureEvent Type, const UAnimNotifyState_SpawnActorBase* Notify, const USkeletalMeshComponent* MeshComp,
+		                 const FAnimNotifyEventReference& EventReference, float Value = 0.f);
+
+		[[nodiscard]] bool Save(const FString& FilePath) const;
+		[[nodiscard]] bool Load(const FString& FilePath);
+		void Reset();
+
+		[[nodiscard]] const TArray<FCapturedNotifyStream>& GetStreams() const
+			{ return Streams; }
+		[[nodiscard]] const TArray<FCapturedNotifyEvent>& GetEvents() const
+			{ return Events; }
+
+	private:
+		TArray<FCapturedNotifyStream> Streams;
+		TArray<FCapturedNotifyEvent> Events;
+
+		/** Only needed while recording. */
+		TMap<TPair<FGuid, FObjectKey>, int32> StreamIndices;
+		TMap<FObjectKey, int32> ComponentKeys;
+	};
+}
@@ -0,0 +1,35 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "AnimationActorPoolable.generated.h"
+
+UINTERFACE(MinimalAPI, BlueprintType)
+class UAnimationActorPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implement on actors spawned by the AnimationActorSystem (e.g. via AnimNotifyState_SpawnActorOfClass)
+ * to allow the UAnimationActorSubsystem to pool them instead of destroying and respawning them.
+ * Any state the actor accumulates while in use has to be reset in OnReleasedToPool().
+ */
+class ANIMATIONACTORSYSTEM_API IAnimationActorPoolable
+{
+	GENERATED_BODY()
+
+public:
+	/** Called after the actor has been detached, hidden and parked in the pool. Reset any gameplay state here. */
+	UFUNCTION(BlueprintNativeEvent, Category="AnimActor")
+	void OnReleasedToPool();
+	virtual void OnReleasedToPool_Implementation() {}
+
+	/** Called when the actor is taken from the pool again, right before it gets handed to the notify. */
+	UFUNCTION(BlueprintNativeEvent, Category="AnimActor")
+	void OnTakenFromPool();
+	virtual void OnTakenFromPool_Implementation() {}
+};
@@ -0,0 +1,53 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+namespace AnimActorSys
+{
+	/**
+	 * Remembers which assets had to be loaded synchronously by spawn notifies in a map, so they can be preloaded
+	 * asynchronously the next time the map is played. Persisted per map in Saved/AnimationActorSystem/PreloadCache.
+	 * Entries that are neither sync-loaded nor requested for a number of sessions are dropped again.
+	 */
+	class ANIMATIONACTORSYSTEM_API FPreloadCache
+	{
+	public:
+		/** Reads the cache file of MapPackageName. Any previous state is discarded. */
+		void Load(const FString& MapPackageName);
+
+		/** Merges this session's observations into the entries and writes them to the cache file of the loaded map. */
+		void Save();
+
+		/** Records that Path was sync-loaded during this session, taking LoadTimeMs. */
+		void RecordSyncLoad(const FSoftObjectPath& Path, float LoadTimeMs);
+
+		/** Records that Path was needed by a notify during this session, so preloading it was worthwhile. */
+		void MarkUsed(const FSoftObjectPath& Path);
+
+		/** All assets worth preloading, most expensive first. */
+		[[nodiscard]] TArray<FSoftObjectPath> GetPathsToPreload() const;
+
+		[[nodiscard]] bool IsLoaded() const
+			{ return !CacheFilePath.IsEmpty(); }
+
+	private:
+		struct FEntry
+		{
+			/** The most recently observed synchronous load time. */
+			float LoadTimeMs = 0.f;
+
+			/** Sessions in a row this entry was loaded but never needed. */
+			int32 UnusedSessions = 0;
+
+			bool bSyncLoadedThisSession = false;
+			bool bUsedThisSession = false;
+		};
+
+		TMap<FSoftObjectPath, FEntry> Entries;
+		FString CacheFilePath;
+	};
+}
@@ -0,0 +1,22 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/SkeletalMeshActor.h"
+#include "AnimationActorSkeletalMeshActor.generated.h"
+
+/**
+ * SkeletalMeshActor stripped of everything a held prop doesn't need: no actor tick, collision, overlaps or physics bodies.
+ * Its mesh is a UAnimationActorSkeletalMeshComponent, so its animation cost follows the mesh that spawned it.
+ * Opt in via UAnimationActorSystemSettings::SkeletalMeshActorClass. Notifies can still enable collision via their profile override.
+ */
+UCLASS(NotPlaceable)
+class ANIMATIONACTORSYSTEM_API AAnimationActorSkeletalMeshActor : public ASkeletalMeshActor
+{
+	GENERATED_BODY()
+
+public:
+	AAnimationActorSkeletalMeshActor(const FObjectInitializer& ObjectInitializer);
+};
@@ -0,0 +1,44 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "AnimationActorSkeletalMeshComponent.generated.h"
+
+/**
+ * Skeletal mesh component spawned by UAnimNotifyState_SpawnSkeletalMesh, which scales its animation cost with the mesh that spawned it.
+ * Depending on the "Animation Budget" settings, it updates and evaluates only in the frames its source does, and follows its LOD.
+ */
+UCLASS(ClassGroup=(AnimActor))
+class ANIMATIONACTORSYSTEM_API UAnimationActorSkeletalMeshComponent : public USkeletalMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+	/** Starts following Source's update rate and LOD. Pass nullptr to stop, e.g. when the component is released to a pool. */
+	void SetUpdateRateSource(USkeletalMeshComponent* Source);
+
+	/** Sets the forced LOD of a reduced significance tier, 0 for none. Following the source's LOD never picks a finer LOD than this. */
+	void SetSignificanceLOD(int32 ForcedLOD);
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+	void InheritUpdateRate(const USkeletalMeshComponent& Source, float DeltaTime);
+
+	/** Hands the update rate back to the component itself, dropping everything InheritUpdateRate() set up. */
+	void StopInheritingUpdateRate();
+	void FollowLOD(const USkeletalMeshComponent& Source);
+
+	TWeakObjectPtr<USkeletalMeshComponent> UpdateRateSource;
+
+	/** Forced LOD set by SetSignificanceLOD(), 1 based like SetForcedLOD(). */
+	int32 SignificanceLOD = 0;
+
+	/** Time of the frames skipped with the source, handed to the next update. */
+	float SkippedTime = 0.f;
+
+	bool bInheritingUpdateRate = false;
+};
@@ -0,0 +1,21 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StaticMeshActor.h"
+#include "AnimationActorStaticMeshActor.generated.h"
+
+/**
+ * StaticMeshActor stripped of everything a held prop doesn't need: no actor tick, collision, overlaps or physics bodies.
+ * Opt in via UAnimationActorSystemSettings::StaticMeshActorClass. Notifies can still enable collision via their profile override.
+ */
+UCLASS(NotPlaceable)
+class ANIMATIONACTORSYSTEM_API AAnimationActorStaticMeshActor : public AStaticMeshActor
+{
+	GENERATED_BODY()
+
+public:
+	AAnimationActorStaticMeshActor(const FObjectInitializer& ObjectInitializer);
+};
@@ -5,16 +5,32 @@
 
 #include "CoreMinimal.h"
 #include "AnimationActorTypes.h"
+#include "AnimationActorMemoryReport.h"
+#include "AnimationActorNotifyCapture.h"
+#include "AnimationActorPreloadCache.h"
+#include "Containers/Queue.h"
+#include "Engine/StreamableManager.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
 #include "AnimationActorSubsystem.generated.h"
 
+class UAnimNotifyState_SpawnActorBase;
+class UAnimSequenceBase;
+class UPrimitiveComponent;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+class UStaticMesh;
 class UWorld;
 
 /**
  * Subsystem to manage spawning, tracking, and destroying AnimActors.
+ * Spawns and releases requested by notifies are queued and processed within a per-frame time budget,
+ * see UAnimationActorSystemSettings::bUseFrameBudget.
+ * Everything is game thread only, except for the Enqueue* functions and the Guid lookups (IsAnimActorRegistered, GetNumAnimActors),
+ * which may be called from any thread.
  */
 UCLASS(Transient)
-class ANIMATIONACTORSYSTEM_API UAnimationActorSubsystem : public UWorldSubsystem
+class ANIMATIONACTORSYSTEM_API UAnimationActorSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 public:
@@ -22,23 +38,370 @@ public:
 
 	/** A tag put on all spawned AnimActors to be able to identify them. */
 	static FName SpawnedAnimActorTag;
+
+	/** Asset registry tag on animations listing everything their spawn notifies need loaded, separated by ';'. */
+	static FName SpawnDependenciesAssetRegistryTag;
+
+	/** Same as SpawnDependenciesAssetRegistryTag, for while AnimActorSys.SkeletalMeshFallback is enabled. */
+	static FName SpawnFallbackDependenciesAssetRegistryTag;
+
+	/** Reads the spawn dependencies of Animation from the asset registry, without loading the animation.
+	 * Takes AnimActorSys.SkeletalMeshFallback into account. */
+	static void GetAnimationSpawnDependencies(const FSoftObjectPath& Animation, TArray<FSoftObjectPath>& OutDependencies);
+
+	/** Loads everything the spawn notifies of Animations (e.g. a character's anim set) need, in a single async request.
+	 * The dependencies are resolved from the asset registry, so the animations themselves are not loaded.
+	 * The assets stay loaded as long as the returned handle is held. Call ReleaseHandle() or let it go to allow unloading them.
+	 * @return nullptr if none of the animations have spawn dependencies. */
+	TSharedPtr<FStreamableHandle> PreloadAnimationDependencies(TConstArrayView<TSoftObjectPtr<UAnimSequenceBase>> Animations,
+	                                                           FStreamableDelegate OnLoaded = FStreamableDelegate());
 	
-	AActor* SpawnAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform, const FGuid Guid);
+	/** Spawns (or reuses) the AnimActor for Guid right away, ignoring the frame budget.
+	 * PreSpawnInitialization is called before the components of a newly spawned actor are registered, so anything set up there
+	 * (mesh, collision, ...) is only set up once. Pooled and pre-spawned actors are passed to it right after they're taken.
+	 * It's not called if Guid already has an actor. */
+	AActor* SpawnAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform, const FGuid Guid,
+	                       const TFunction<void(AActor*)>& PreSpawnInitialization = nullptr);
+
+	/** Requests the AnimActor for Guid. It is spawned right away if there is frame budget left,
+	 * otherwise it's queued by Priority and spawned in a later frame.
+	 * OnSpawned is called once the actor exists. If the request is cancelled by DestroyAnimActor before that,
+	 * nothing gets spawned and OnSpawned is never called. */
+	void RequestAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform, const FGuid Guid,
+	                      int32 Priority, TFunction<void(AActor*)>&& OnSpawned,
+	                      TFunction<void(AActor*)>&& PreSpawnInitialization = nullptr);
+
+	/** Thread-safe versions of RequestAnimActor(), DestroyAnimActor() and moving an AnimActor, to be called from any thread.
+	 * The requests are queued without locking and processed in order on the game thread at the start of the next Tick.
+	 * Spawn requests go through AdmitAnimActor() first, so they may be refused once a concurrency cap is reached. */
+	void EnqueueSpawnRequest(const TSubclassOf<AActor>& Class, const FTransform& Transform, const FGuid& Guid,
+	                         int32 Priority = 0, TFunction<void(AActor*)>&& OnSpawned = nullptr);
+	void EnqueueDestroyRequest(const FGuid& Guid);
+	void EnqueueTransformUpdate(const FGuid& Guid, const FTransform& RelativeTransform);
+
 	[[nodiscard]] AActor* GetAnimActorByGuid(const FGuid& GuidToLookFor) const;
+
+	/** Whether anything (an actor or an instance) is registered for Guid. Pending requests don't count. */
+	[[nodiscard]] bool IsAnimActorRegistered(const FGuid& Guid) const
+		{ return Registry.Contains(Guid); }
+
+	/** Amount of registered actors, components and instances. */
+	[[nodiscard]] int32 GetNumAnimActors() const
+		{ return Registry.Num(); }
+
+	/** Adds a component of Class to the owner of AttachParent (or reuses a pooled one), attached to Bone and registered under Guid like an AnimActor.
+	 * If Guid is already registered, the existing component is returned. Remove it again via DestroyAnimActor().
+	 * PreRegistration is called before a new component is registered, or right after taking one from the pool. */
+	UPrimitiveComponent* SpawnAnimComponent(const TSubclassOf<UPrimitiveComponent>& Class, USkeletalMeshComponent* AttachParent,
+	                                        const FName Bone, const FTransform& RelativeTransform,
+	                                        const bool bWeldSimulatedBodies, const FGuid Guid,
+	                                        const TFunction<void(UPrimitiveComponent*)>& PreRegistration = nullptr);
+
+	/** The component representing the AnimActor for Guid: the spawned component in Component mode, otherwise the actor's root. */
+	[[nodiscard]] USceneComponent* GetAnimComponentByGuid(const FGuid& Guid) const;
+
+	/** Adds an instance of Mesh that follows Bone of AttachParent, registered under Guid like an AnimActor.
+	 * All instances of the same mesh share one instanced static mesh component, which is updated in a single batched pass each frame.
+	 * Remove it again via DestroyAnimActor(). */
+	bool AddAnimActorInstance(UStaticMesh* Mesh, USkeletalMeshComponent* AttachParent, const FName Bone,
+	                          const FTransform& RelativeTransform, const FGuid Guid);
+
+	/** Removes one user from the AnimActor for Guid (or its pending request).
+	 * Once no users are left, the actor is hidden and queued to be released to its pool or destroyed. */
 	void DestroyAnimActor(const FGuid Guid);
 
-#pragma region UWorldSubsystem Interface
+	/** Lets Component, which plays Animation in sync with its owner, share its pose with other meshes playing Animation at the same time.
+	 * It either follows one of them, or evaluates for those that join later. No-op unless bSharePoseEvaluation is enabled. */
+	void JoinSharedPoseGroup(USkeletalMeshComponent* Component, const UAnimSequenceBase* Animation);
+
+	/** Stops sharing the pose of Component. If it evaluated for others, one of them takes over. */
+	void LeaveSharedPoseGroup(USkeletalMeshComponent* Component);
+
+	/** The map from the bones of Target to the bones of Source with the same name. Built on a worker thread on the first request
+	 * for a pair of meshes and cached from then on, so it may not be ready yet. */
+	TSharedRef<const AnimActorSys::FBoneIndexMap> GetBoneIndexMap(const USkeletalMesh* Source, const USkeletalMesh* Target);
+
+	/** Loads all of Paths synchronously, one by one, and records those that weren't loaded yet with their load time
+	 * in the preload cache, so they get preloaded the next time this map is played. */
+	void SyncLoadAssets(TConstArrayView<FSoftObjectPath> Paths);
+
+	/** Keeps the loaded objects at Paths from being garbage collected while this world is around,
+	 * so notifies don't have to load them again every time. */
+	void KeepAssetsLoaded(TConstArrayView<FSoftObjectPath> Paths);
+
+	/** Spawns inactive actors of Class into its pool until it holds Count actors, capped by the class' MaxPoolSize. */
+	void PrewarmPool(const TSubclassOf<AActor>& Class, int32 Count);
+
+	/** Observe the montages playing on Component, and start streaming (and optionally pre-spawning) for spawn notifies
+	 * that are about to trigger within the LookaheadWindowSeconds. */
+	UFUNCTION(BlueprintCallable, Category="AnimActor")
+	void RegisterLookaheadComponent(USkeletalMeshComponent* Component);
+
+	UFUNCTION(BlueprintCallable, Category="AnimActor")
+	void UnregisterLookaheadComponent(USkeletalMeshComponent* Component);
+
+	/** How significant a notify fired by Owner is, based on the distance to the closest viewer, its screen size and whether it is rendered. */
+	[[nodiscard]] EAnimActorSignificance EvaluateSignificance(const USkeletalMeshComponent* Owner) const;
+
+	/** Checks whether another AnimActor for Guid fits into the concurrency caps, evicting less important ones if the policy allows.
+	 * Every admitted notify is counted until its DestroyAnimActor() call.
+	 * @return false if the notify must not spawn anything. Call SkipAnimActor() in that case. */
+	bool AdmitAnimActor(const FGuid& Guid, const UClass* Class, const UObject* Asset, int32 Priority,
+	                    const USceneComponent* Owner);
+
+	/** Records a notify that decided not to spawn anything for Guid, so its DestroyAnimActor() call is expected. */
+	void SkipAnimActor(const FGuid& Guid);
+
+	/** Like SkipAnimActor(), for a notify that was admitted but failed to spawn. Gives its admission back, so it doesn't count towards the caps. */
+	void CancelAnimActor(const FGuid& Guid);
+
+	/** Records a notify that waits for its class and assets to load before it spawns for Guid.
+	 * A DestroyAnimActor() call in the meantime cancels it, instead of looking for something to destroy. */
+	void BeginPendingLoad(const FGuid& Guid);
+
+	/** Ends a load started by BeginPendingLoad().
+	 * @return false if it was cancelled, in which case the notify must not spawn anything anymore. */
+	[[nodiscard]] bool FinishPendingLoad(const FGuid& Guid);
+
+	/** Applies the significance of Owner to whatever is registered for Guid, and keeps updating it while it's active. */
+	void TrackSignificance(const FGuid& Guid, USkeletalMeshComponent* Owner);
+
+	/** Starts recording every Begin, Tick and End of the spawn notifies in this world, see AnimationActorReplayCommandlet to replay it. */
+	UFUNCTION(BlueprintCallable, Category="AnimActor|Capture")
+	void StartNotifyCapture();
+
+	/** Stops the recording and writes it to FilePath, or into Saved/AnimationActorSystem/Captures if empty.
+	 * @return The file the capture was written to, empty if nothing was recorded or writing failed. */
+	UFUNCTION(BlueprintCallable, Category="AnimActor|Capture")
+	FString StopNotifyCapture(const FString& FilePath = TEXT(""));
+
+	[[nodiscard]] bool IsCapturingNotifies() const
+		{ return NotifyCapture.IsValid(); }
+
+	/** Collects everything this subsystem holds onto: live AnimActors grouped by class and mesh, pooled and lingering ones,
+	 * and the referenced classes and assets, each with their estimated CPU and GPU resource size. */
+	void GatherMemoryReport(AnimActorSys::FMemoryReport& OutReport) const;
+
+	/** Adds a notify event to the running capture. Called by the notifies, no-op while not capturing. */
+	void RecordNotifyEvent(AnimActorSys::ENotifyCaptureEvent Type, const UAnimNotifyState_SpawnActorBase* Notify,
+	                       const USkeletalMeshComponent* MeshComp, const FAnimNotifyEventReference& EventReference, float Value = 0.f);
+
+	/** Switches the Actor, or the Component if there is no actor, to the quality tier of Significance.
+	 * The state a reduced tier changes is saved into RestoreState on the first reduction and restored from it at Full. */
+	static void ApplySignificance(AActor* Actor, UPrimitiveComponent* Component, EAnimActorSignificance Significance,
+	                              AnimActorSys::FSignificanceRestoreState& RestoreState);
+
+#pragma region UTickableWorldSubsystem Interface
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
 	
 protected:
 	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
 #pragma endregion
 	
 private:
-	/** Spawned actors mapped as the GUID this system receives from the Notify to a counter of actor pointers. */
-	TMap<FGuid, AnimActorSys::FActorCounter> SpawnedActors;
+	/** Spawns a new actor of Class and marks it as AnimActor. Does not register it with any Guid.
+	 * PreSpawnInitialization runs before its components are registered. */
+	AActor* SpawnNewAnimActor(const TSubclassOf<AActor>& Class, const FTransform& Transform,
+	                          const TFunction<void(AActor*)>& PreSpawnInitialization = nullptr) const;
+
+	/** Takes an inactive actor of Class from its pool and reactivates it at Transform. */
+	AActor* AcquireFromPool(const TSubclassOf<AActor>& Class, const FTransform& Transform);
+
+	/** Detaches, hides and parks the Actor in the pool of its class.
+	 * @return false if the class isn't poolable or its pool is full, in which case the actor is left untouched. */
+	bool ReleaseToPool(AActor* Actor);
+
+	/** Spawns the pools configured in the UAnimationActorSystemSettings for Class. */
+	void PrewarmPoolFromSettings(const TSubclassOf<AActor>& Class);
+
+	/** Releases the Actor to its pool or destroys it if it can't be pooled. Counts towards the frame budget. */
+	void ReleaseOrDestroy(AActor* Actor);
+
+	/** Whether queued work may be processed right now, or has to wait for a later frame. */
+	[[nodiscard]] bool HasFrameBudgetLeft();
+
+	/** Hands all requests enqueued from other threads to the regular, game thread functions. */
+	void ProcessAsyncRequests();
+
+	/** Spawns queued requests and releases queued actors until the frame budget is used up. */
+	void ProcessQueuedRequests();
+
+	void ExecuteSpawnRequest(AnimActorSys::FPendingSpawnRequest& Request);
+
+	/** Finds spawn notifies about to trigger on the LookaheadComponents and prepares them. */
+	void UpdateLookahead();
+
+	/** Pre-spawns actors for entries whose class finished loading, and drops expired entries. */
+	void ProcessLookaheadEntries();
+
+	/** Takes the actor pre-spawned for Guid, if it matches Class, and reveals it at Transform. */
+	AActor* TakePreSpawnedActor(const FGuid& Guid, const TSubclassOf<AActor>& Class, const FTransform& Transform);
+
+	/** Takes an inactive component of Class from Owner's pool and reactivates it. */
+	UPrimitiveComponent* AcquireComponentFromPool(AActor* Owner, const TSubclassOf<UPrimitiveComponent>& Class);
+
+	/** Detaches, hides and parks the Component on its owner, or destroys it if the owner's pool is full. */
+	void ReleaseAnimComponent(UPrimitiveComponent* Component);
+
+	/** Returns the index of the FInstanceBatch for Mesh, creating its component if needed. */
+	int32 FindOrAddInstanceBatch(UStaticMesh* Mesh);
+	void RemoveAnimActorInstance(const AnimActorSys::FAnimActorSlot& Slot);
+
+	/** Moves all instances to their attach parent's bones. */
+	void UpdateInstanceTransforms();
+
+	/** Squared distance from Location to the closest player's view point, or TNumericLimits<double>::Max() without players. */
+	[[nodiscard]] double GetDistanceSquaredToClosestViewer(const FVector& Location, float* OutFOV = nullptr) const;
+
+	/** Removes one user from whatever is registered for Guid. DestroyAnimActor() without the skipped notifies. */
+	void ReleaseAnimActorUser(const FGuid& Guid);
+
+	/** Removes the admission of Guid and takes it off the per-class and per-asset counts. */
+	void RemoveAdmission(const FGuid& Guid);
+
+	/** Ends all users of Guid right away. Their notifies' DestroyAnimActor() calls are treated like skipped ones. */
+	void EvictAnimActor(const FGuid& Guid);
+
+	/** Keeps Class from being garbage collected and records it as used right now. */
+	void MarkClassReferenced(const TSubclassOf<AActor>& Class);
+
+	/** Checks every ReferenceReleaseCheckInterval for idle references and memory pressure, and handles pending memory trims. */
+	void UpdateReferenceRelease();
+
+	/** Bound to FCoreDelegates::GetMemoryTrimDelegate(). Thread-safe, the references are released in the next Tick. */
+	void RequestMemoryTrim()
+		{ bPendingMemoryTrim = true; }
+
+	/** Lets go of the classes and assets that haven't been used for ReferenceIdleReleaseSeconds, or of all of them under memory pressure.
+	 * Classes preloaded on BeginPlay are never released. */
+	void ReleaseIdleReferences(bool bMemoryPressure);
+
+	/** Moves followers that drifted further than the SharedPoseTimeTolerance from their leader into another group. */
+	void UpdateSharedPoseGroups();
+
+	/** Puts Component into the group of Animation whose leader is within the SharedPoseTimeTolerance of Time, or starts a new one. */
+	void AddToSharedPoseGroup(USkeletalMeshComponent* Component, const UAnimSequenceBase* Animation, float Time);
+
+	/** Counts a reuse (or the lack of one) towards the pool hit rate. */
+	void RecordPoolAccess(bool bHit);
+
+	/** Publishes live counts and the pool hit rate to the stats, the CSV profiler and the trace. */
+	void UpdateStats() const;
+
+	/** Picks up changes of the scalability console variables that affect already spawned or pooled AnimActors. */
+	void ApplyScalabilityChanges();
+
+	/** Sets the tick interval of the Actor and all its components, or only of the Component if there is no actor. */
+	static void ApplyTickInterval(AActor* Actor, UActorComponent* Component, float TickInterval);
+
+	/** Re-evaluates the significance of all tracked entries, every SignificanceUpdateInterval. */
+	void UpdateSignificance();
+
+	/** Re-evaluates the significance of Slot's owner and switches its actor or component to the new tier, if it changed. */
+	void UpdateSlotSignificance(AnimActorSys::FAnimActorSlot& Slot) const;
+
+	/** Requests enqueued from any thread, drained on the game thread once per frame. */
+	TQueue<AnimActorSys::FAsyncAnimActorRequest, EQueueMode::Mpsc> AsyncRequests;
+
+	/** Requests waiting to be spawned, sorted by ascending priority so the next one to process is the last. */
+	TArray<AnimActorSys::FPendingSpawnRequest> PendingSpawns;
+
+	/** Hidden actors without users, waiting to be released to their pool or destroyed. */
+	TArray<TWeakObjectPtr<AActor>> PendingReleases;
+
+	/** Time spent on spawning and releasing during the current frame. */
+	double FrameBudgetSpentSeconds = 0.0;
+
+	/** Operations processed during the current frame. */
+	int32 FrameBudgetOperationCount = 0;
+
+	/** GFrameCounter of the frame the budget values belong to. */
+	uint64 FrameBudgetFrame = 0;
+
+	/** Notifies counted towards the concurrency caps. */
+	TMap<FGuid, AnimActorSys::FAnimActorAdmission> Admissions;
+
+	/** Amount of Admissions per class and per asset, for the per-class and per-mesh caps. */
+	TMap<TObjectKey<UClass>, int32> AdmissionsPerClass;
+	TMap<TObjectKey<UObject>, int32> AdmissionsPerAsset;
+
+	/** Notifies that were skipped or evicted, with the amount of users that still have to end. */
+	TMap<FGuid, int32> SkippedSpawns;
+
+	/** Notifies waiting for their class and assets to load, see BeginPendingLoad(). */
+	TMap<FGuid, AnimActorSys::FPendingLoad> PendingLoads;
+
+	double LastSignificanceUpdateTime = 0.0;
+
+	double LastReferenceReleaseCheckTime = 0.0;
+
+	/** Bound to FCoreDelegates::GetMemoryTrimDelegate(). */
+	FDelegateHandle MemoryTrimDelegateHandle;
+
+	/** Set by RequestMemoryTrim() from any thread, handled by UpdateReferenceRelease() on the game thread. */
+	std::atomic<bool> bPendingMemoryTrim = false;
+
+	/** Scalability values the spawned and pooled AnimActors currently reflect. */
+	float AppliedTickInterval = 0.f;
+	float AppliedPoolSizeScale = 1.f;
+
+	/** Spawns that could and couldn't reuse a pooled actor or component this session. */
+	int32 PoolHitCount = 0;
+	int32 PoolMissCount = 0;
+
+	/** Spawned actors registered by the GUID this system receives from the Notify, each with a counter of its users. */
+	AnimActorSys::FAnimActorRegistry Registry;
+
+	/** Referenced classes to hold onto, to prevent them from being GC'd. Released again once idle, see ReleaseIdleReferences(). */
+	UPROPERTY(Transient)
+	TSet<TSubclassOf<AActor>> ReferencedAnimActorClasses;
+
+	/** Assets loaded for notifies (meshes, animations, ...), held to prevent them from being GC'd */
+	UPROPERTY(Transient)
+	TSet<TObjectPtr<UObject>> ReferencedAnimAssets;
+
+	/** FPlatformTime::Seconds() of the last time each referenced class or asset was needed by a notify. */
+	TMap<FObjectKey, double> ReferenceLastUseTimes;
+
+	/** Assets that had to be sync-loaded in previous sessions of this map. */
+	AnimActorSys::FPreloadCache PreloadCache;
+
+	/** Keeps the assets preloaded from the PreloadCache loaded. */
+	TSharedPtr<FStreamableHandle> PreloadCacheHandle;
+
+	/** Components whose montages are observed by the lookahead. */
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>> LookaheadComponents;
+
+	/** Notifies about to trigger, by the Guid they will spawn their actor with. */
+	TMap<FGuid, AnimActorSys::FLookaheadEntry> LookaheadEntries;
+
+	/** The running notify capture, if any. */
+	TUniquePtr<AnimActorSys::FNotifyCapture> NotifyCapture;
+
+	/** GFrameCounter of the last frame marker in the NotifyCapture. */
+	uint64 NotifyCaptureFrame = 0;
+
+	/** Inactive actors ready to be reused, per class. */
+	TMap<TSubclassOf<AActor>, AnimActorSys::FActorPool> ActorPools;
+
+	/** Inactive components ready to be reused, per owning actor and component class. */
+	TMap<TPair<TObjectKey<AActor>, TObjectKey<UClass>>, TArray<TWeakObjectPtr<UPrimitiveComponent>>> ComponentPools;
+
+	/** Groups of skeletal meshes sharing a pose, per mesh and animation. */
+	TMap<TPair<FObjectKey, FObjectKey>, TArray<AnimActorSys::FSharedPoseGroup>> SharedPoseGroups;
+	TMap<TObjectKey<USkeletalMeshComponent>, TPair<FObjectKey, FObjectKey>> SharedPoseGroupKeys;
+
+	/** Per source and target mesh, see GetBoneIndexMap(). Maps no anim instance uses anymore are dropped by ReleaseIdleReferences(). */
+	TMap<TPair<FObjectKey, FObjectKey>, TSharedRef<AnimActorSys::FBoneIndexMap>> BoneIndexMaps;
+
+	/** Instanced static meshes spawned in EAnimActorStaticMeshSpawnMode::Instanced. */
+	TArray<AnimActorSys::FInstanceBatch> InstanceBatches;
+	TMap<TObjectKey<UStaticMesh>, int32> InstanceBatchIndices;
 
-	/** List of referenced classes to hold onto, to prevent them from being GC'd */
+	/** Actor owning the instanced static mesh components of the InstanceBatches. */
 	UPROPERTY(Transient)
-	TArray<TSubclassOf<AActor>> ReferencedAnimActorClasses;
+	TObjectPtr<AActor> InstanceHostActor = nullptr;
 };
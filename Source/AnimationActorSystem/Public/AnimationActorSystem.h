@@ -8,6 +8,23 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogAnimActorSys, Log, All);
 
+struct FAssetRegistryTagsContext;
+struct FSoftObjectPath;
+
 class FAnimationActorSystemModule : public IModuleInterface
 {
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+private:
+#if WITH_EDITOR
+	/** Adds the spawn dependencies of all AnimNotifyState_SpawnActorBase notifies to the tags of the owning animation. */
+	static void AddSpawnDependencyTags(FAssetRegistryTagsContext Context);
+
+	/** Adds Dependencies as a single tag, unless there are none. */
+	static void AddDependencyTag(FAssetRegistryTagsContext& Context, FName Tag, TConstArrayView<FSoftObjectPath> Dependencies);
+	
+	FDelegateHandle ExtraObjectTagsHandle;
+#endif
 };
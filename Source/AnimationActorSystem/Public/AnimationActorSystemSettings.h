@@ -26,7 +26,8 @@ public:
 #pragma endregion
 
 #pragma region Skeletal Meshes
-	/** The SkeletalMeshActor class to spawn by UAnimNotifyState_SpawnSkeletalMeshActor. */
+	/** The SkeletalMeshActor class to spawn by UAnimNotifyState_SpawnSkeletalMeshActor.
+	 * AAnimationActorSkeletalMeshActor comes without tick and collision, which is all most held props need. */
 	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Skeletal Mesh")
 	TSoftClassPtr<ASkeletalMeshActor> SkeletalMeshActorClass = ASkeletalMeshActor::StaticClass();
 
@@ -41,7 +42,8 @@ public:
 #pragma endregion
 
 #pragma region Static Meshes
-	/** The StaticMeshActor class to spawn by UAnimNotifyState_SpawnStaticMeshActor. */
+	/** The StaticMeshActor class to spawn by UAnimNotifyState_SpawnStaticMeshActor.
+	 * AAnimationActorStaticMeshActor comes without tick and collision, which is all most held props need. */
 	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Static Mesh")
 	TSoftClassPtr<AStaticMeshActor> StaticMeshActorClass = AStaticMeshActor::StaticClass();
 
@@ -55,6 +57,202 @@ public:
 	bool bStaticCanAffectNavigation = true;
 #pragma endregion
 
+#pragma region Pooling
+	/** Whether released AnimActors should be parked and reused instead of being destroyed and spawned again. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Pooling")
+	bool bEnableActorPooling = true;
+
+	/** Pool settings for the SkeletalMeshActorClass, the StaticMeshActorClass
+	 * and any class implementing IAnimationActorPoolable that has no entry in PerClassPoolSettings. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableActorPooling"), Category="Pooling")
+	FAnimActorPoolSettings DefaultPoolSettings;
+
+	/** Pool settings for specific classes. Classes spawned via AnimNotifyState_SpawnActorOfClass are only pooled
+	 * if they are listed here or implement IAnimationActorPoolable, since we can't know how to reset their state otherwise. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableActorPooling"), Category="Pooling")
+	TMap<TSoftClassPtr<AActor>, FAnimActorPoolSettings> PerClassPoolSettings;
+
+	/** How many released components of each class to keep on an actor for reuse, for notifies spawning in Component mode. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableActorPooling", ClampMin=0), Category="Pooling")
+	int32 MaxPooledComponentsPerOwner = 2;
+#pragma endregion
+
+#pragma region Scheduling
+	/** Whether spawning and releasing AnimActors is limited by FrameBudgetMs.
+	 * Requests exceeding the budget are queued by priority and processed in the following frames. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Scheduling")
+	bool bUseFrameBudget = true;
+
+	/** Time in milliseconds the subsystem may spend on spawning and releasing AnimActors per frame. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bUseFrameBudget", ClampMin=0, Units="ms"), Category="Scheduling")
+	float FrameBudgetMs = 1.f;
+
+	/** Amount of spawns/releases that are processed each frame, even if that exceeds the budget. Guarantees the queue always progresses. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bUseFrameBudget", ClampMin=1), Category="Scheduling")
+	int32 MinOperationsPerFrame = 1;
+#pragma endregion
+
+#pragma region Concurrency
+	/** Maximum amount of AnimActors (including instances and components) alive per world at once. 0 is unlimited. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0), Category="Concurrency")
+	int32 MaxLiveAnimActors = 0;
+
+	/** Maximum amount of AnimActors of a class alive per world at once. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0), Category="Concurrency")
+	TMap<TSoftClassPtr<AActor>, int32> MaxLiveAnimActorsPerClass;
+
+	/** Maximum amount of AnimActors spawning a mesh alive per world at once. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0, AllowedClasses="/Script/Engine.StaticMesh,/Script/Engine.SkeletalMesh"), Category="Concurrency")
+	TMap<TSoftObjectPtr<UObject>, int32> MaxLiveAnimActorsPerMesh;
+
+	/** What happens once a cap is reached. Notifies are compared by their SpawnPriority. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Concurrency")
+	EAnimActorConcurrencyPolicy ConcurrencyPolicy = EAnimActorConcurrencyPolicy::EvictLowestPriority;
+#pragma endregion
+
+#pragma region Lookahead
+	/** How far ahead (in seconds of montage time) to look for spawn notifies on components registered
+	 * via UAnimationActorSubsystem::RegisterLookaheadComponent. Their assets start streaming once they're within this window. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0, Units="s"), Category="Lookahead")
+	float LookaheadWindowSeconds = 0.5f;
+
+	/** Whether to also spawn the actor hidden ahead of time, so the trigger frame only has to reveal and attach it. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Lookahead")
+	bool bPreSpawnInLookahead = true;
+#pragma endregion
+
+#pragma region Significance
+	/** Whether notifies spawn at reduced quality or not at all if their owner is far away, small on screen or not rendered.
+	 * Spawned actors are promoted and demoted while their notify is active. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Significance")
+	bool bEnableSignificance = true;
+
+	/** Owners farther away from the closest viewer spawn at reduced quality. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableSignificance", ClampMin=0, Units="cm"), Category="Significance")
+	float ReducedSignificanceDistance = 3000.f;
+
+	/** Owners farther away from the closest viewer don't spawn at all. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableSignificance", ClampMin=0, Units="cm"), Category="Significance")
+	float SkipSignificanceDistance = 10000.f;
+
+	/** Owners whose bounds cover less than this fraction of the screen height spawn at reduced quality. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableSignificance", ClampMin=0, ClampMax=1), Category="Significance")
+	float ReducedSignificanceScreenSize = 0.05f;
+
+	/** Owners that haven't been rendered for this long spawn at reduced quality. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableSignificance", ClampMin=0, Units="s"), Category="Significance")
+	float SignificanceRenderTimeTolerance = 0.2f;
+
+	/** How often the significance of active AnimActors is re-evaluated. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnableSignificance", ClampMin=0, Units="s"), Category="Significance")
+	float SignificanceUpdateInterval = 0.25f;
+#pragma endregion
+
+#pragma region Preload Cache
+	/** Whether to remember assets that had to be loaded synchronously by a notify, and preload them asynchronously
+	 * on BeginPlay the next time the same map is played. The cache is stored per map in Saved/AnimationActorSystem/PreloadCache. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Preload Cache")
+	bool bEnablePreloadCache = true;
+
+	/** Synchronous loads faster than this are not worth remembering. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnablePreloadCache", ClampMin=0, Units="ms"), Category="Preload Cache")
+	float PreloadCacheMinLoadTimeMs = 1.f;
+
+	/** Sessions in a row a preloaded asset may go unused before it's dropped from the cache. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnablePreloadCache", ClampMin=0), Category="Preload Cache")
+	int32 PreloadCacheMaxUnusedSessions = 5;
+
+	/** Maximum amount of assets to preload per map. The ones that took longest to load are kept. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bEnablePreloadCache", ClampMin=0), Category="Preload Cache")
+	int32 PreloadCacheMaxEntries = 256;
+#pragma endregion
+
+#pragma region Server
+	/** What spawn notifies do on dedicated servers. Unless everything is spawned, the BeginPlay preloads are skipped there as well,
+	 * and the remaining classes are loaded when first requested.
+	 * Check that gameplay doesn't rely on any notify marked as cosmetic before switching to SkipCosmetic. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Server")
+	EAnimActorServerPolicy DedicatedServerPolicy = EAnimActorServerPolicy::SpawnAll;
+#pragma endregion
+
+#pragma region Memory
+	/** Whether actor classes and assets loaded for notifies are let go again once they haven't been needed for a while,
+	 * so they can be garbage collected. Classes preloaded on BeginPlay stay referenced for the whole session. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Memory")
+	bool bReleaseIdleReferences = true;
+
+	/** How long a class or asset has to go unused before it's released. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bReleaseIdleReferences", ClampMin=0, Units="s"), Category="Memory")
+	float ReferenceIdleReleaseSeconds = 120.f;
+
+	/** Once less physical memory than this is available, or the platform asks to trim memory, all references that aren't pinned
+	 * are released right away, along with the assets preloaded from the preload cache. 0 only reacts to the platform. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bReleaseIdleReferences", ClampMin=0, Units="MB"), Category="Memory")
+	int32 LowMemoryThresholdMB = 0;
+
+	/** How often idle references and the available memory are checked. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bReleaseIdleReferences", ClampMin=0, Units="s"), Category="Memory")
+	float ReferenceReleaseCheckInterval = 5.f;
+#pragma endregion
+
+#pragma region Animation Budget
+	/** Whether skeletal meshes spawned in AnimSequence or AnimBlueprint mode update at the rate of the mesh that spawned them,
+	 * skipping the frames it skips due to update rate optimizations or the animation budget allocator.
+	 * Needs the SkeletalMeshActorClass to use a UAnimationActorSkeletalMeshComponent, like AAnimationActorSkeletalMeshActor does.
+	 * The default ASkeletalMeshActor doesn't, so in the Actor spawn mode this only applies once that is changed.
+	 * To have the spawned meshes budgeted on their own instead, use an actor class with a USkeletalMeshComponentBudgeted and disable this. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Animation Budget")
+	bool bInheritOwnerUpdateRate = true;
+
+	/** Whether those meshes are forced to the LOD of the mesh that spawned them. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Animation Budget")
+	bool bFollowOwnerLOD = true;
+
+	/** Whether skeletal meshes spawned in AnimSequence mode share one pose evaluation if they play the same animation on the same mesh
+	 * at nearly the same time. One of them evaluates, the others follow it as their leader pose. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, Category="Animation Budget")
+	bool bSharePoseEvaluation = false;
+
+	/** How far apart in time meshes may be and still share a pose. They snap to the time of the evaluating mesh. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(EditCondition="bSharePoseEvaluation", ClampMin=0, Units="s"), Category="Animation Budget")
+	float SharedPoseTimeTolerance = 0.05f;
+#pragma endregion
+
+	/** Returns the pool settings that apply to Class, scaled by AnimActorSys.PoolSizeScale.
+	 * MaxPoolSize is 0 if the class should not be pooled at all. */
+	FAnimActorPoolSettings GetPoolSettingsForClass(const UClass* Class) const;
+
+	/** Whether a notify has to be skipped in a world with NetMode, following the DedicatedServerPolicy. */
+	[[nodiscard]] bool ShouldSkipNotify(ENetMode NetMode, bool bCosmetic) const
+	{
+		return NetMode == NM_DedicatedServer && (DedicatedServerPolicy == EAnimActorServerPolicy::SkipAll
+			|| (DedicatedServerPolicy == EAnimActorServerPolicy::SkipCosmetic && bCosmetic));
+	}
+
+	/** Whether Class is loaded on BeginPlay, either as Skeletal/StaticMeshActorClass or to prewarm its pool.
+	 * These stay referenced for the whole session. */
+	[[nodiscard]] bool IsClassPreloadedOnBeginPlay(const UClass* Class) const;
+
+#pragma region Scalability
+	/** The following combine the config above with the AnimActorSys.* console variables, which are meant to be set
+	 * by scalability groups and device profiles. They are read on every use, so changes apply at runtime. */
+	
+	/** AnimActorSys.Enabled. If false, notifies don't spawn anything. */
+	[[nodiscard]] bool IsSystemEnabled() const;
+
+	/** AnimActorSys.PoolSizeScale. Applied to all pool sizes by GetPoolSettingsForClass(). */
+	[[nodiscard]] float GetPoolSizeScale() const;
+
+	/** AnimActorSys.MaxLiveActors if set, otherwise MaxLiveAnimActors. */
+	[[nodiscard]] int32 GetMaxLiveAnimActors() const;
+
+	/** AnimActorSys.TickInterval. Applied to spawned actors and components, 0 ticks every frame. */
+	[[nodiscard]] float GetAnimActorTickInterval() const;
+
+	/** AnimActorSys.SkeletalMeshFallback. Whether skeletal mesh notifies spawn their static fallback mesh instead. */
+	[[nodiscard]] bool ShouldUseSkeletalMeshFallback() const;
+#pragma endregion
+
 	static const UAnimationActorSystemSettings* Get()
 		{ return GetDefault<UAnimationActorSystemSettings>(); };
 	
@@ -7,9 +7,17 @@
 #include "GameFramework/Actor.h"
 #include "Animation/AnimNotifyQueue.h"
 #include "Animation/MirrorDataTable.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
 
 #include "AnimationActorTypes.generated.h"
 
+struct FStreamableHandle;
+class UInstancedStaticMeshComponent;
+class UPrimitiveComponent;
+class USkeletalMeshComponent;
+
 UENUM(BlueprintType)
 enum class EAnimActorClassLoadingBehaviour: uint8
 {
@@ -26,6 +34,93 @@ enum class EAnimActorAnimationMode: uint8
 	PoseLeader					UMETA(ToolTip="Use the mesh that plays the source animation as a Pose Leader component"),
 	AnimSequence				UMETA(ToolTip="Play an AnimSequence on the spawned mesh"),
 	AnimBlueprint				UMETA(ToolTip="Apply an AnimationBlueprint to the spawned mesh"),
+	CopyPose					UMETA(ToolTip="Copy the pose of the mesh that plays the source animation by bone name. Works across skeletons"),
+};
+
+/** How a static mesh spawned by a notify state should be represented in the world. */
+UENUM(BlueprintType)
+enum class EAnimActorStaticMeshSpawnMode: uint8
+{
+	Actor						UMETA(ToolTip="Spawn a StaticMeshActor attached to the bone"),
+	Instanced					UMETA(ToolTip="Add an instance to an instanced static mesh component shared by all notifies spawning the same mesh. Has no collision."),
+	Component					UMETA(ToolTip="Add a StaticMeshComponent to the owning actor, attached to the bone"),
+};
+
+/** How a skeletal mesh spawned by a notify state should be represented in the world. */
+UENUM(BlueprintType)
+enum class EAnimActorSkeletalMeshSpawnMode: uint8
+{
+	Actor						UMETA(ToolTip="Spawn a SkeletalMeshActor attached to the bone"),
+	Component					UMETA(ToolTip="Add a SkeletalMeshComponent to the owning actor, attached to the bone"),
+};
+
+/** How much an AnimActor is worth spending on, based on how noticeable its owner is to the viewer. */
+UENUM(BlueprintType)
+enum class EAnimActorSignificance: uint8
+{
+	Full						UMETA(ToolTip="Spawn as configured by the notify"),
+	Reduced						UMETA(ToolTip="No collision and shadows, lowest LOD and frozen animation"),
+	Skip						UMETA(ToolTip="Don't spawn at all, or hide if already spawned"),
+};
+
+/** What to do when a new AnimActor would exceed one of the concurrency caps. */
+UENUM(BlueprintType)
+enum class EAnimActorConcurrencyPolicy: uint8
+{
+	EvictLowestPriority			UMETA(ToolTip="Remove the lowest priority AnimActor (the farthest on ties) if it's less important than the new one, otherwise refuse the new one"),
+	RefuseNew					UMETA(ToolTip="Don't spawn the new AnimActor"),
+};
+
+/** What spawn notifies do on dedicated servers, where nobody sees the AnimActors. */
+UENUM(BlueprintType)
+enum class EAnimActorServerPolicy: uint8
+{
+	SpawnAll					UMETA(ToolTip="Spawn everything, like on clients"),
+	SkipCosmetic				UMETA(ToolTip="Don't load or spawn anything for notifies marked as cosmetic"),
+	SkipAll						UMETA(ToolTip="Don't load or spawn anything for any notify"),
+};
+
+/** How many actors of a class the UAnimationActorSubsystem keeps around for reuse. */
+USTRUCT(BlueprintType)
+struct FAnimActorPoolSettings
+{
+	GENERATED_BODY()
+
+	/** How many actors to spawn into the pool on BeginPlay. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0), Category="Pooling")
+	int32 PrewarmCount = 0;
+
+	/** Maximum amount of inactive actors to keep. Released actors exceeding this are destroyed. 0 disables pooling. */
+	UPROPERTY(Config, BlueprintReadWrite, EditAnywhere, meta=(ClampMin=0), Category="Pooling")
+	int32 MaxPoolSize = 8;
+};
+
+/** Features of the spawned actor or component a notify can switch off, because the spawn doesn't need them.
+ * Applied after the notify configured the spawn and before its components are registered, where possible. */
+USTRUCT(BlueprintType)
+struct FAnimActorSpawnProfile
+{
+	GENERATED_BODY()
+
+	/** Disable the actor tick and the tick of components that don't need it to animate. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	bool bDisableTick = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	bool bDisableOverlapEvents = false;
+
+	/** Disable collision, so no physics bodies are created. Wins over any collision profile override of the notify. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	bool bDisablePhysics = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	bool bDisableShadows = false;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category="AnimActor")
+	bool bDisableDecals = false;
+
+	bool IsEmpty() const
+		{ return !bDisableTick && !bDisableOverlapEvents && !bDisablePhysics && !bDisableShadows && !bDisableDecals; }
 };
 
 namespace AnimActorSys
@@ -99,4 +194,349 @@ namespace AnimActorSys
 		
 		int Counter = 0;
 	};
+
+	/**
+	 * Stable, cheap to copy reference to an entry in the FAnimActorRegistry.
+	 * Stays safe to use after the entry got removed, it just won't resolve anymore.
+	 */
+	struct FAnimActorHandle
+	{
+		int32 Index = INDEX_NONE;
+		uint32 Generation = 0;
+
+		[[nodiscard]] bool IsValid() const
+			{ return Index != INDEX_NONE; }
+
+		bool operator==(const FAnimActorHandle& Other) const
+			{ return Index == Other.Index && Generation == Other.Generation; }
+	};
+
+	/** A single entry of the FAnimActorRegistry. */
+	/** What a reduced significance tier changes, saved before the first reduction and restored once it's back at full significance,
+	 * so whatever the notify configured at spawn (e.g. its FAnimActorSpawnProfile, or a forced LOD) survives the round trip. */
+	struct FSignificanceRestoreState
+	{
+		struct FPrimitiveState
+		{
+			TWeakObjectPtr<UPrimitiveComponent> Component = nullptr;
+			int32 ForcedLOD = 0;
+			bool bCastShadow = true;
+			bool bPauseAnims = false;
+		};
+
+		TArray<FPrimitiveState> Primitives;
+		bool bActorEnableCollision = true;
+		bool bSaved = false;
+
+		void Reset()
+		{
+			Primitives.Reset();
+			bActorEnableCollision = true;
+			bSaved = false;
+		}
+	};
+
+	struct FAnimActorSlot
+	{
+		FGuid Guid;
+		FActorCounter Counter = FActorCounter(nullptr);
+		uint32 Generation = 0;
+		bool bInUse = false;
+
+		/** Set if this entry is an instance in one of the subsystem's FInstanceBatches instead of an actor. */
+		int32 InstanceBatchIndex = INDEX_NONE;
+		int32 InstanceIndex = INDEX_NONE;
+
+		/** Set if this entry is a component added to the notify owner instead of an actor. */
+		TWeakObjectPtr<UPrimitiveComponent> Component = nullptr;
+
+		/** The mesh that fired the notify, if the significance of this entry is tracked. */
+		TWeakObjectPtr<USkeletalMeshComponent> SignificanceOwner = nullptr;
+		EAnimActorSignificance Significance = EAnimActorSignificance::Full;
+		FSignificanceRestoreState SignificanceRestoreState;
+	};
+
+	/**
+	 * Slot map of registered AnimActors. Entries are addressed by FAnimActorHandle in O(1),
+	 * the Guid lookup is only needed once to obtain the handle.
+	 * Freed slots are reused, so steady state spawning and destroying does not allocate.
+	 * Guid lookups (Find, Contains, Num) are safe from any thread. Everything else, including Resolve, is game thread only.
+	 */
+	class FAnimActorRegistry
+	{
+	public:
+		FAnimActorHandle Add(const FGuid& Guid, AActor* Actor)
+		{
+			const int32 Index = FreeIndices.IsEmpty() ? Slots.AddDefaulted() : FreeIndices.Pop(EAllowShrinking::No);
+			FAnimActorSlot& Slot = Slots[Index];
+			Slot.Guid = Guid;
+			Slot.Counter = FActorCounter(Actor);
+			Slot.bInUse = true;
+			Slot.InstanceBatchIndex = INDEX_NONE;
+			Slot.InstanceIndex = INDEX_NONE;
+			Slot.Component = nullptr;
+			Slot.SignificanceOwner = nullptr;
+			Slot.Significance = EAnimActorSignificance::Full;
+			Slot.SignificanceRestoreState.Reset();
+
+			const FAnimActorHandle Handle{Index, Slot.Generation};
+			FWriteScopeLock WriteLock(GuidLock);
+			GuidToHandle.Add(Guid, Handle);
+			return Handle;
+		}
+
+		void Remove(const FAnimActorHandle Handle)
+		{
+			if (FAnimActorSlot* Slot = Resolve(Handle))
+			{
+				{
+					FWriteScopeLock WriteLock(GuidLock);
+					GuidToHandle.Remove(Slot->Guid);
+				}
+				Slot->Counter = FActorCounter(nullptr);
+				Slot->bInUse = false;
+				Slot->InstanceBatchIndex = INDEX_NONE;
+				Slot->InstanceIndex = INDEX_NONE;
+				Slot->Component = nullptr;
+				Slot->SignificanceOwner = nullptr;
+				Slot->Significance = EAnimActorSignificance::Full;
+				Slot->SignificanceRestoreState.Reset();
+				++Slot->Generation;
+				FreeIndices.Add(Handle.Index);
+			}
+		}
+
+		[[nodiscard]] FAnimActorHandle Find(const FGuid& Guid) const
+		{
+			FReadScopeLock ReadLock(GuidLock);
+			const FAnimActorHandle* Handle = GuidToHandle.Find(Guid);
+			return Handle ? *Handle : FAnimActorHandle();
+		}
+
+		[[nodiscard]] FAnimActorSlot* Resolve(const FAnimActorHandle Handle)
+		{
+			return Slots.IsValidIndex(Handle.Index) && Slots[Handle.Index].bInUse && Slots[Handle.Index].Generation == Handle.Generation
+				? &Slots[Handle.Index] : nullptr;
+		}
+
+		[[nodiscard]] const FAnimActorSlot* Resolve(const FAnimActorHandle Handle) const
+			{ return const_cast<FAnimActorRegistry*>(this)->Resolve(Handle); }
+
+		[[nodiscard]] bool Contains(const FGuid& Guid) const
+		{
+			FReadScopeLock ReadLock(GuidLock);
+			return GuidToHandle.Contains(Guid);
+		}
+
+		/** Calls Func(FAnimActorHandle, FAnimActorSlot&) for every slot in use. */
+		template<typename FuncType>
+		void ForEach(FuncType&& Func)
+		{
+			for (int32 Index = 0; Index < Slots.Num(); ++Index)
+			{
+				if (Slots[Index].bInUse)
+				{
+					Func(FAnimActorHandle{Index, Slots[Index].Generation}, Slots[Index]);
+				}
+			}
+		}
+
+		template<typename FuncType>
+		void ForEach(FuncType&& Func) const
+		{
+			for (int32 Index = 0; Index < Slots.Num(); ++Index)
+			{
+				if (Slots[Index].bInUse)
+				{
+					Func(FAnimActorHandle{Index, Slots[Index].Generation}, Slots[Index]);
+				}
+			}
+		}
+
+		[[nodiscard]] int32 Num() const
+		{
+			FReadScopeLock ReadLock(GuidLock);
+			return GuidToHandle.Num();
+		}
+
+	private:
+		TArray<FAnimActorSlot> Slots;
+		TArray<int32> FreeIndices;
+		TMap<FGuid, FAnimActorHandle> GuidToHandle;
+
+		/** Guards GuidToHandle, which is only written on the game thread but may be read from any. */
+		mutable FRWLock GuidLock;
+	};
+
+	/**
+	 * A spawn that has been requested from the UAnimationActorSubsystem, but didn't fit into the frame budget yet.
+	 */
+	struct FPendingSpawnRequest
+	{
+		FGuid Guid;
+		TSubclassOf<AActor> Class = nullptr;
+		FTransform Transform = FTransform::Identity;
+
+		/** Higher priority requests are processed first. */
+		int32 Priority = 0;
+
+		/** How often this request has been made for the same Guid. Once cancelled down to 0, it's dropped. */
+		int32 Count = 1;
+
+		/** Called with the spawned actor. */
+		TFunction<void(AActor*)> OnSpawned;
+
+		/** Called with the actor before its components are registered, see UAnimationActorSubsystem::SpawnAnimActor(). */
+		TFunction<void(AActor*)> PreSpawnInitialization;
+	};
+
+	/** What an FAsyncAnimActorRequest asks for. */
+	enum class EAsyncAnimActorRequestType : uint8
+	{
+		/** UAnimationActorSubsystem::RequestAnimActor() */
+		Spawn,
+		/** UAnimationActorSubsystem::DestroyAnimActor() */
+		Destroy,
+		/** Moves whatever is registered for the Guid, or its pending spawn, to Transform relative to its attach parent. */
+		SetTransform,
+	};
+
+	/**
+	 * A request made from any thread, waiting for the game thread to process it.
+	 */
+	struct FAsyncAnimActorRequest
+	{
+		EAsyncAnimActorRequestType Type = EAsyncAnimActorRequestType::Spawn;
+		FGuid Guid;
+		TWeakObjectPtr<UClass> Class = nullptr;
+		FTransform Transform = FTransform::Identity;
+		int32 Priority = 0;
+
+		/** Called on the game thread with the spawned actor. */
+		TFunction<void(AActor*)> OnSpawned;
+	};
+
+	/**
+	 * A notify that got admitted by the concurrency caps, whether it's spawned yet or still pending.
+	 */
+	struct FAnimActorAdmission
+	{
+		TObjectKey<UClass> Class;
+
+		/** The mesh the notify spawns, for the per-asset caps. */
+		TObjectKey<UObject> Asset;
+
+		/** Where the notify was fired from, to find the farthest entry on priority ties. */
+		TWeakObjectPtr<const USceneComponent> Owner = nullptr;
+
+		int32 Priority = 0;
+
+		/** Notifies that began for this Guid and haven't ended yet. */
+		int32 Users = 0;
+	};
+
+	/**
+	 * A spawn notify that is about to trigger on a component observed by the lookahead.
+	 */
+	struct FLookaheadEntry
+	{
+		/** Keeps the notify's dependencies loaded until it triggers. */
+		TSharedPtr<FStreamableHandle> StreamingHandle;
+
+		/** The actor class to pre-spawn, once loaded. */
+		TSoftClassPtr<AActor> Class = nullptr;
+
+		/** Registered actor, hidden and without collision, waiting for the notify to trigger. */
+		TWeakObjectPtr<AActor> PreSpawnedActor = nullptr;
+
+		/** Whether an actor should still be pre-spawned for this entry. */
+		bool bWantsPreSpawn = false;
+
+		/** World time after which the notify is assumed to not trigger anymore (e.g. the montage got interrupted). */
+		double ExpireTime = 0.0;
+	};
+
+	/**
+	 * All instances of a single static mesh, rendered by one instanced static mesh component.
+	 * The arrays are parallel to the component's instances and are kept in the same order.
+	 */
+	struct FInstanceBatch
+	{
+		TWeakObjectPtr<UInstancedStaticMeshComponent> Component = nullptr;
+
+		/** Registry entry of each instance, to fix up its InstanceIndex when instances get swapped around. */
+		TArray<FAnimActorHandle> Owners;
+		TArray<TWeakObjectPtr<const USkeletalMeshComponent>> AttachParents;
+		TArray<FName> AttachBones;
+		TArray<FTransform> RelativeTransforms;
+
+		/** Scratch buffer the world transforms are computed into each frame. */
+		TArray<FTransform> WorldTransforms;
+	};
+
+	/** Loads of notifies for a single Guid that haven't finished yet, and how many of them were cancelled by their NotifyEnd. */
+	struct FPendingLoad
+	{
+		int32 Pending = 0;
+		int32 Cancelled = 0;
+	};
+
+	/**
+	 * Inactive actors of a single class, waiting to be reused.
+	 */
+	struct FActorPool
+	{
+		/** Pops the most recently released actor that is still valid, or nullptr if none is left. */
+		AActor* Pop()
+		{
+			while (!InactiveActors.IsEmpty())
+			{
+				if (AActor* Actor = InactiveActors.Pop(EAllowShrinking::No).Get(); IsValid(Actor))
+				{
+					return Actor;
+				}
+			}
+			return nullptr;
+		}
+
+		void Push(AActor* Actor)
+			{ InactiveActors.Emplace(Actor); }
+
+		[[nodiscard]] int32 Num() const
+			{ return InactiveActors.Num(); }
+
+		[[nodiscard]] const TArray<TWeakObjectPtr<AActor>>& GetInactiveActors() const
+			{ return InactiveActors; }
+
+	private:
+		TArray<TWeakObjectPtr<AActor>> InactiveActors;
+	};
+
+	/**
+	 * Spawned skeletal meshes playing the same animation at nearly the same time.
+	 * Only the Leader evaluates its pose, the Followers use it as their leader pose.
+	 */
+	struct FSharedPoseGroup
+	{
+		TWeakObjectPtr<USkeletalMeshComponent> Leader;
+		TArray<TWeakObjectPtr<USkeletalMeshComponent>> Followers;
+
+		/** The follower to check for drift next, they take turns. */
+		int32 NextDriftCheck = 0;
+	};
+
+	/**
+	 * Maps the bones of a target mesh to the bones of a source mesh with the same name, to copy poses between different skeletons.
+	 * Built asynchronously, so check IsReady() before reading it.
+	 */
+	struct FBoneIndexMap
+	{
+		/** Source mesh bone index per target mesh bone index, INDEX_NONE where the source has no bone of that name. */
+		TArray<int32> SourceBoneIndices;
+
+		std::atomic<bool> bReady = false;
+
+		[[nodiscard]] bool IsReady() const
+			{ return bReady.load(std::memory_order_acquire); }
+	};
 }
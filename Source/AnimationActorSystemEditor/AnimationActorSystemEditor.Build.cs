@@ -22,6 +22,7 @@ public class AnimationActorSystemEditor : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "Json",
                 "Slate",
                 "SlateCore",
                 "Projects"
@@ -0,0 +1,322 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorBenchmarkCommandlet.h"
+
+#include "AnimationActorBenchmarkUtils.h"
+#include "AnimationActorSubsystem.h"
+#include "AnimNotifyState_SpawnActorOfClass.h"
+#include "AnimNotifyState_SpawnSkeletalMesh.h"
+#include "AnimNotifyState_SpawnStaticMesh.h"
+#include "Animation/AnimSequence.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnimActorBenchmark, Log, All);
+
+namespace AnimActorBenchmark
+{
+	struct FConfig
+	{
+		TArray<FString> Notifies = {TEXT("StaticMesh"), TEXT("SkeletalMesh"), TEXT("ActorOfClass")};
+		int32 NumComponents = 100;
+		int32 NumFrames = 600;
+		int32 Interval = 30;
+		int32 Duration = 20;
+		int32 Stagger = 1;
+		float DeltaTime = 1.f / 60.f;
+		FString StaticMeshSpawnMode = TEXT("Actor");
+		FString StaticMesh = TEXT("/Engine/BasicShapes/Cube.Cube");
+		FString SkeletalMesh;
+		FString ActorClass = TEXT("/Script/Engine.StaticMeshActor");
+		FString OutputPath = FPaths::ProjectSavedDir() / TEXT("AnimationActorSystem") / TEXT("Benchmark.json");
+
+		void Parse(const TCHAR* Params)
+		{
+			FString NotifyList;
+			const bool bExplicitNotifies = FParse::Value(Params, TEXT("Notifies="), NotifyList);
+			if (bExplicitNotifies)
+			{
+				NotifyList.ParseIntoArray(Notifies, TEXT(","));
+			}
+			FParse::Value(Params, TEXT("Components="), NumComponents);
+			FParse::Value(Params, TEXT("Frames="), NumFrames);
+			FParse::Value(Params, TEXT("Interval="), Interval);
+			FParse::Value(Params, TEXT("Duration="), Duration);
+			FParse::Value(Params, TEXT("Stagger="), Stagger);
+			FParse::Value(Params, TEXT("StaticMeshSpawnMode="), StaticMeshSpawnMode);
+			FParse::Value(Params, TEXT("StaticMesh="), StaticMesh);
+			FParse::Value(Params, TEXT("SkeletalMesh="), SkeletalMesh);
+			FParse::Value(Params, TEXT("ActorClass="), ActorClass);
+			FParse::Value(Params, TEXT("Output="), OutputPath);
+
+			// There's no skeletal mesh to default to, so only an explicit request without one is an error.
+			if (!bExplicitNotifies && SkeletalMesh.IsEmpty())
+			{
+				Notifies.Remove(TEXT("SkeletalMesh"));
+			}
+
+			NumComponents = FMath::Max(NumComponents, 1);
+			Interval = FMath::Max(Interval, 1);
+			Duration = FMath::Max(Duration, 1);
+			Stagger = FMath::Max(Stagger, 0);
+		}
+	};
+
+	struct FResult
+	{
+		FString Notify;
+		int32 NotifiesBegun = 0;
+		int32 PeakLiveAnimActors = 0;
+		double WallSeconds = 0.0;
+		int64 MemoryDeltaBytes = 0;
+		int64 ResidualMemoryDeltaBytes = 0;
+		FLatencySamples NotifyBegin;
+		FLatencySamples NotifyTick;
+		FLatencySamples NotifyEnd;
+		FLatencySamples WorldTick;
+	};
+
+	UAnimNotifyState_SpawnActorBase* CreateNotify(const FString& Name, const FConfig& Config)
+	{
+		UAnimNotifyState_SpawnActorBase* Notify = nullptr;
+		if (Name == TEXT("StaticMesh"))
+		{
+			UAnimNotifyState_SpawnStaticMesh* StaticMeshNotify = NewObject<UAnimNotifyState_SpawnStaticMesh>(GetTransientPackage());
+			StaticMeshNotify->MeshToSpawn = TSoftObjectPtr<UStaticMesh>(FSoftObjectPath(Config.StaticMesh));
+			const int64 SpawnMode = StaticEnum<EAnimActorStaticMeshSpawnMode>()->GetValueByNameString(Config.StaticMeshSpawnMode);
+			StaticMeshNotify->SpawnMode = SpawnMode != INDEX_NONE
+				? static_cast<EAnimActorStaticMeshSpawnMode>(SpawnMode) : EAnimActorStaticMeshSpawnMode::Actor;
+			Notify = StaticMeshNotify;
+		}
+		else if (Name == TEXT("SkeletalMesh"))
+		{
+			// The engine doesn't ship a skeletal mesh that's guaranteed to be around, so one has to be provided.
+			if (Config.SkeletalMesh.IsEmpty())
+			{
+				UE_LOG(LogAnimActorBenchmark, Error, TEXT("Skipping SkeletalMesh, no mesh provided. Pass -SkeletalMesh=<Path> to benchmark it."))
+				return nullptr;
+			}
+			UAnimNotifyState_SpawnSkeletalMesh* SkeletalMeshNotify = NewObject<UAnimNotifyState_SpawnSkeletalMesh>(GetTransientPackage());
+			SkeletalMeshNotify->MeshToSpawn = TSoftObjectPtr<USkeletalMesh>(FSoftObjectPath(Config.SkeletalMesh));
+			SkeletalMeshNotify->AnimationMode = EAnimActorAnimationMode::PoseLeader;
+			Notify = SkeletalMeshNotify;
+		}
+		else if (Name == TEXT("ActorOfClass"))
+		{
+			UAnimNotifyState_SpawnActorOfClass* ActorOfClassNotify = NewObject<UAnimNotifyState_SpawnActorOfClass>(GetTransientPackage());
+			ActorOfClassNotify->ClassToSpawn = TSoftClassPtr<AActor>(FSoftObjectPath(Config.ActorClass));
+			Notify = ActorOfClassNotify;
+		}
+		else
+		{
+			UE_LOG(LogAnimActorBenchmark, Error, TEXT("Skipping unknown notify %s."), *Name)
+		}
+
+		if (Notify)
+		{
+			Notify->StaticPartialAnimActorGuid = FGuid::NewGuid();
+
+			// Loading is not what's measured here, and async loads would never finish without an engine loop.
+			TArray<FSoftObjectPath> Dependencies;
+			Notify->GatherSpawnDependencies(Dependencies);
+			for (const FSoftObjectPath& Dependency : Dependencies)
+			{
+				// Spawning nothing would make for a great, but meaningless result.
+				if (!Dependency.TryLoad())
+				{
+					UE_LOG(LogAnimActorBenchmark, Error, TEXT("Skipping %s, failed to load %s."), *Name, *Dependency.ToString())
+					return nullptr;
+				}
+			}
+		}
+		return Notify;
+	}
+
+	TOptional<FResult> Run(const FString& NotifyName, const FConfig& Config)
+	{
+		UAnimNotifyState_SpawnActorBase* Notify = CreateNotify(NotifyName, Config);
+		if (!Notify)
+		{
+			return {};
+		}
+		Notify->AddToRoot();
+
+		FResult Result;
+		Result.Notify = NotifyName;
+
+		const uint64 MemoryBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+		UWorld* World = CreateWorld(TEXT("AnimActorBenchmark"));
+		const UAnimationActorSubsystem* Subsystem = UAnimationActorSubsystem::Get(World);
+
+		UAnimSequence* Animation = NewObject<UAnimSequence>(GetTransientPackage());
+		Animation->AddToRoot();
+		FAnimNotifyEvent NotifyEvent;
+		NotifyEvent.NotifyStateClass = Notify;
+		NotifyEvent.SetDuration(Config.Duration * Config.DeltaTime);
+		const FAnimNotifyEventReference EventReference(&NotifyEvent, Animation);
+
+		TArray<USkeletalMeshComponent*> Components;
+		for (int32 Index = 0; Index < Config.NumComponents; ++Index)
+		{
+			AActor* Owner = World->SpawnActor<AActor>();
+			USkeletalMeshComponent* Component = NewObject<USkeletalMeshComponent>(Owner);
+			Owner->SetRootComponent(Component);
+			Component->RegisterComponent();
+			Components.Add(Component);
+		}
+
+		struct FActiveNotify
+		{
+			int32 ComponentIndex;
+			int32 EndFrame;
+		};
+		TArray<FActiveNotify> ActiveNotifies;
+
+		const double StartTime = FPlatformTime::Seconds();
+		auto TickWorld = [&]()
+		{
+			GFrameCounter++;
+			const uint64 StartCycle = FPlatformTime::Cycles64();
+			World->Tick(LEVELTICK_All, Config.DeltaTime);
+			Result.WorldTick.Add(FPlatformTime::Cycles64() - StartCycle);
+			Result.PeakLiveAnimActors = FMath::Max(Result.PeakLiveAnimActors, Subsystem ? Subsystem->GetNumAnimActors() : 0);
+		};
+
+		for (int32 Frame = 0; Frame < Config.NumFrames; ++Frame)
+		{
+			for (int32 ActiveIndex = ActiveNotifies.Num() - 1; ActiveIndex >= 0; --ActiveIndex)
+			{
+				USkeletalMeshComponent* Component = Components[ActiveNotifies[ActiveIndex].ComponentIndex];
+				const uint64 StartCycle = FPlatformTime::Cycles64();
+				if (ActiveNotifies[ActiveIndex].EndFrame <= Frame)
+				{
+					Notify->NotifyEnd(Component, Animation, EventReference);
+					Result.NotifyEnd.Add(FPlatformTime::Cycles64() - StartCycle);
+					ActiveNotifies.RemoveAtSwap(ActiveIndex, 1, EAllowShrinking::No);
+				}
+				else
+				{
+					Notify->NotifyTick(Component, Animation, Config.DeltaTime, EventReference);
+					Result.NotifyTick.Add(FPlatformTime::Cycles64() - StartCycle);
+				}
+			}
+
+			for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ++ComponentIndex)
+			{
+				const int32 Phase = Frame - ComponentIndex * Config.Stagger;
+				if (Phase < 0 || Phase % Config.Interval != 0)
+				{
+					continue;
+				}
+				const uint64 StartCycle = FPlatformTime::Cycles64();
+				Notify->NotifyBegin(Components[ComponentIndex], Animation, NotifyEvent.GetDuration(), EventReference);
+				Result.NotifyBegin.Add(FPlatformTime::Cycles64() - StartCycle);
+				ActiveNotifies.Add({ComponentIndex, Frame + Config.Duration});
+				Result.NotifiesBegun++;
+			}
+
+			TickWorld();
+		}
+
+		for (const FActiveNotify& ActiveNotify : ActiveNotifies)
+		{
+			const uint64 StartCycle = FPlatformTime::Cycles64();
+			Notify->NotifyEnd(Components[ActiveNotify.ComponentIndex], Animation, EventReference);
+			Result.NotifyEnd.Add(FPlatformTime::Cycles64() - StartCycle);
+		}
+		// Releases deferred by the frame budget still count towards the run.
+		for (int32 FlushFrame = 0; FlushFrame < 10; ++FlushFrame)
+		{
+			TickWorld();
+		}
+		Result.WallSeconds = FPlatformTime::Seconds() - StartTime;
+		Result.MemoryDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(MemoryBefore);
+
+		Animation->RemoveFromRoot();
+		Notify->RemoveFromRoot();
+		DestroyWorld(World);
+		Result.ResidualMemoryDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(MemoryBefore);
+
+		UE_LOG(LogAnimActorBenchmark, Display, TEXT("%s: %d notifies in %.2fs, peak %d live AnimActors, %lld bytes memory delta."),
+			*NotifyName, Result.NotifiesBegun, Result.WallSeconds, Result.PeakLiveAnimActors, Result.MemoryDeltaBytes)
+		return Result;
+	}
+}
+
+UAnimationActorBenchmarkCommandlet::UAnimationActorBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAnimationActorBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace AnimActorBenchmark;
+
+	FConfig Config;
+	Config.Parse(*Params);
+
+	TArray<FResult> Results;
+	bool bSkippedNotifies = false;
+	for (const FString& NotifyName : Config.Notifies)
+	{
+		if (TOptional<FResult> Result = Run(NotifyName, Config))
+		{
+			Results.Add(MoveTemp(*Result));
+		}
+		else
+		{
+			bSkippedNotifies = true;
+		}
+	}
+
+	FString Json;
+	const TSharedRef<FJsonWriter> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteObjectStart(TEXT("Config"));
+	Writer->WriteValue(TEXT("Components"), Config.NumComponents);
+	Writer->WriteValue(TEXT("Frames"), Config.NumFrames);
+	Writer->WriteValue(TEXT("Interval"), Config.Interval);
+	Writer->WriteValue(TEXT("Duration"), Config.Duration);
+	Writer->WriteValue(TEXT("Stagger"), Config.Stagger);
+	Writer->WriteValue(TEXT("StaticMeshSpawnMode"), Config.StaticMeshSpawnMode);
+	Writer->WriteObjectEnd();
+
+	Writer->WriteArrayStart(TEXT("Results"));
+	for (FResult& Result : Results)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("Notify"), Result.Notify);
+		Writer->WriteValue(TEXT("NotifiesBegun"), Result.NotifiesBegun);
+		Writer->WriteValue(TEXT("WallSeconds"), Result.WallSeconds);
+		Writer->WriteValue(TEXT("NotifiesPerSecond"), Result.WallSeconds > 0.0 ? Result.NotifiesBegun / Result.WallSeconds : 0.0);
+		Writer->WriteValue(TEXT("PeakLiveAnimActors"), Result.PeakLiveAnimActors);
+		Writer->WriteValue(TEXT("MemoryDeltaBytes"), Result.MemoryDeltaBytes);
+		Writer->WriteValue(TEXT("ResidualMemoryDeltaBytes"), Result.ResidualMemoryDeltaBytes);
+		Writer->WriteObjectStart(TEXT("LatencyMicroseconds"));
+		Result.NotifyBegin.Write(*Writer, TEXT("NotifyBegin"));
+		Result.NotifyTick.Write(*Writer, TEXT("NotifyTick"));
+		Result.NotifyEnd.Write(*Writer, TEXT("NotifyEnd"));
+		Result.WorldTick.Write(*Writer, TEXT("WorldTick"));
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Json, *Config.OutputPath))
+	{
+		UE_LOG(LogAnimActorBenchmark, Error, TEXT("Failed to write benchmark results to %s."), *Config.OutputPath)
+		return 1;
+	}
+	UE_LOG(LogAnimActorBenchmark, Display, TEXT("Wrote benchmark results to %s."), *Config.OutputPath)
+	return bSkippedNotifies ? 1 : 0;
+}
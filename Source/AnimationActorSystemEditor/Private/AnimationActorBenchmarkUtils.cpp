@@ -0,0 +1,51 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorBenchmarkUtils.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace AnimActorBenchmark
+{
+	void FLatencySamples::Write(FJsonWriter& Writer, const FString& Name)
+	{
+		Microseconds.Sort();
+		auto Percentile = [this](const double Fraction)
+		{
+			return Microseconds.IsEmpty() ? 0.0 : Microseconds[FMath::Min(FMath::FloorToInt32(Fraction * Microseconds.Num()), Microseconds.Num() - 1)];
+		};
+		double Sum = 0.0;
+		for (const double Sample : Microseconds)
+		{
+			Sum += Sample;
+		}
+
+		Writer.WriteObjectStart(Name);
+		Writer.WriteValue(TEXT("Count"), Microseconds.Num());
+		Writer.WriteValue(TEXT("Mean"), Microseconds.IsEmpty() ? 0.0 : Sum / Microseconds.Num());
+		Writer.WriteValue(TEXT("P50"), Percentile(0.5));
+		Writer.WriteValue(TEXT("P90"), Percentile(0.9));
+		Writer.WriteValue(TEXT("P99"), Percentile(0.99));
+		Writer.WriteValue(TEXT("Max"), Microseconds.IsEmpty() ? 0.0 : Microseconds.Last());
+		Writer.WriteObjectEnd();
+	}
+
+	UWorld* CreateWorld(const TCHAR* Name)
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, Name);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+		return World;
+	}
+
+	void DestroyWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		CollectGarbage(RF_NoFlags);
+	}
+}
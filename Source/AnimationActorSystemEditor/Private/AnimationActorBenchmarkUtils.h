@@ -0,0 +1,34 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+class UWorld;
+
+/** Shared by the benchmark and replay commandlets. */
+namespace AnimActorBenchmark
+{
+	using FJsonWriter = TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>;
+
+	/** Per-call timings of one notify function, in microseconds. */
+	struct FLatencySamples
+	{
+		void Add(const uint64 Cycles)
+			{ Microseconds.Add(FPlatformTime::ToMilliseconds64(Cycles) * 1000.0); }
+
+		/** Writes count, mean, percentiles and max as an object called Name. */
+		void Write(FJsonWriter& Writer, const FString& Name);
+
+		TArray<double> Microseconds;
+	};
+
+	/** Creates a game world with a world context and begins play in it, so notifies can run in it like in a session. */
+	UWorld* CreateWorld(const TCHAR* Name);
+
+	/** Tears down a world from CreateWorld() and collects garbage. */
+	void DestroyWorld(UWorld* World);
+}
@@ -0,0 +1,239 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorReplayCommandlet.h"
+
+#include "AnimationActorBenchmarkUtils.h"
+#include "AnimationActorNotifyCapture.h"
+#include "AnimationActorSubsystem.h"
+#include "AnimNotifyState_SpawnActorBase.h"
+#include "Animation/AnimSequence.h"
+#include "Animation/MirrorDataTable.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogAnimActorReplay, Log, All);
+
+namespace AnimActorReplay
+{
+	using namespace AnimActorBenchmark;
+	using AnimActorSys::ENotifyCaptureEvent;
+
+	/** A captured stream resolved to the objects needed to fire its notify again. */
+	struct FReplayStream
+	{
+		UAnimNotifyState_SpawnActorBase* Notify = nullptr;
+		UAnimSequenceBase* Animation = nullptr;
+		USkeletalMeshComponent* Component = nullptr;
+		TUniquePtr<FAnimNotifyEvent> NotifyEvent;
+		TOptional<FAnimNotifyEventReference> EventReference;
+		bool bActive = false;
+	};
+
+	struct FResult
+	{
+		int32 Frames = 0;
+		int32 SkippedEvents = 0;
+		int32 PeakLiveAnimActors = 0;
+		double CapturedSeconds = 0.0;
+		double WallSeconds = 0.0;
+		FLatencySamples NotifyBegin;
+		FLatencySamples NotifyTick;
+		FLatencySamples NotifyEnd;
+		FLatencySamples WorldTick;
+	};
+
+	/** Resolves the notify, its animation and mirror table of each stream, and stands in a component for each component key. */
+	TArray<FReplayStream> ResolveStreams(const AnimActorSys::FNotifyCapture& Capture, UWorld* World, UAnimSequenceBase* FallbackAnimation)
+	{
+		TArray<FReplayStream> ReplayStreams;
+		TMap<int32, USkeletalMeshComponent*> Components;
+		for (const AnimActorSys::FCapturedNotifyStream& Stream : Capture.GetStreams())
+		{
+			FReplayStream& ReplayStream = ReplayStreams.AddDefaulted_GetRef();
+			ReplayStream.Notify = Cast<UAnimNotifyState_SpawnActorBase>(Stream.Notify.TryLoad());
+			if (!ReplayStream.Notify)
+			{
+				UE_LOG(LogAnimActorReplay, Warning, TEXT("Failed to load notify %s, its events are skipped."), *Stream.Notify.ToString())
+				continue;
+			}
+
+			// Loading is not what's measured here, and async loads would never finish without an engine loop.
+			TArray<FSoftObjectPath> Dependencies;
+			ReplayStream.Notify->GatherSpawnDependencies(Dependencies);
+			for (const FSoftObjectPath& Dependency : Dependencies)
+			{
+				Dependency.TryLoad();
+			}
+
+			ReplayStream.Animation = ReplayStream.Notify->GetTypedOuter<UAnimSequenceBase>();
+			const FAnimNotifyEvent* ExistingNotifyEvent = nullptr;
+			if (ReplayStream.Animation)
+			{
+				ExistingNotifyEvent = ReplayStream.Animation->Notifies.FindByPredicate([&ReplayStream](const FAnimNotifyEvent& NotifyEvent)
+				{
+					return NotifyEvent.NotifyStateClass == ReplayStream.Notify;
+				});
+			}
+			else
+			{
+				ReplayStream.Animation = FallbackAnimation;
+			}
+			ReplayStream.NotifyEvent = MakeUnique<FAnimNotifyEvent>(ExistingNotifyEvent ? *ExistingNotifyEvent : FAnimNotifyEvent());
+			ReplayStream.NotifyEvent->NotifyStateClass = ReplayStream.Notify;
+			ReplayStream.EventReference.Emplace(ReplayStream.NotifyEvent.Get(), ReplayStream.Animation,
+			                                    Cast<UMirrorDataTable>(Stream.MirrorTable.TryLoad()));
+
+			USkeletalMeshComponent*& Component = Components.FindOrAdd(Stream.ComponentKey);
+			if (!Component)
+			{
+				AActor* Owner = World->SpawnActor<AActor>();
+				Component = NewObject<USkeletalMeshComponent>(Owner);
+				Owner->SetRootComponent(Component);
+				Component->RegisterComponent();
+			}
+			ReplayStream.Component = Component;
+		}
+		return ReplayStreams;
+	}
+
+	void Replay(const AnimActorSys::FNotifyCapture& Capture, const int32 Repeat, FResult& Result)
+	{
+		UWorld* World = CreateWorld(TEXT("AnimActorReplay"));
+		const UAnimationActorSubsystem* Subsystem = UAnimationActorSubsystem::Get(World);
+		UAnimSequence* FallbackAnimation = NewObject<UAnimSequence>(GetTransientPackage());
+		FallbackAnimation->AddToRoot();
+		TArray<FReplayStream> Streams = ResolveStreams(Capture, World, FallbackAnimation);
+
+		auto TickWorld = [&](const float DeltaTime)
+		{
+			GFrameCounter++;
+			const uint64 StartCycle = FPlatformTime::Cycles64();
+			World->Tick(LEVELTICK_All, DeltaTime);
+			Result.WorldTick.Add(FPlatformTime::Cycles64() - StartCycle);
+			Result.PeakLiveAnimActors = FMath::Max(Result.PeakLiveAnimActors, Subsystem ? Subsystem->GetNumAnimActors() : 0);
+			Result.CapturedSeconds += DeltaTime;
+			Result.Frames++;
+		};
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Repeat; ++Iteration)
+		{
+			for (const AnimActorSys::FCapturedNotifyEvent& Event : Capture.GetEvents())
+			{
+				if (Event.Type == ENotifyCaptureEvent::Frame)
+				{
+					TickWorld(Event.Value);
+					continue;
+				}
+
+				FReplayStream* Stream = Streams.IsValidIndex(Event.StreamIndex) ? &Streams[Event.StreamIndex] : nullptr;
+				// Captures started while notifies were active contain their Ticks and Ends without a Begin.
+				if (!Stream || !Stream->Notify || (Event.Type != ENotifyCaptureEvent::Begin && !Stream->bActive))
+				{
+					Result.SkippedEvents++;
+					continue;
+				}
+
+				const uint64 StartCycle = FPlatformTime::Cycles64();
+				switch (Event.Type)
+				{
+					case ENotifyCaptureEvent::Begin:
+						Stream->Notify->NotifyBegin(Stream->Component, Stream->Animation, Event.Value, *Stream->EventReference);
+						Result.NotifyBegin.Add(FPlatformTime::Cycles64() - StartCycle);
+						Stream->bActive = true;
+						break;
+					case ENotifyCaptureEvent::Tick:
+						Stream->Notify->NotifyTick(Stream->Component, Stream->Animation, Event.Value, *Stream->EventReference);
+						Result.NotifyTick.Add(FPlatformTime::Cycles64() - StartCycle);
+						break;
+					default:
+						Stream->Notify->NotifyEnd(Stream->Component, Stream->Animation, *Stream->EventReference);
+						Result.NotifyEnd.Add(FPlatformTime::Cycles64() - StartCycle);
+						Stream->bActive = false;
+						break;
+				}
+			}
+
+			for (FReplayStream& Stream : Streams)
+			{
+				if (Stream.bActive)
+				{
+					Stream.Notify->NotifyEnd(Stream.Component, Stream.Animation, *Stream.EventReference);
+					Stream.bActive = false;
+				}
+			}
+		}
+		Result.WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+		FallbackAnimation->RemoveFromRoot();
+		DestroyWorld(World);
+	}
+}
+
+UAnimationActorReplayCommandlet::UAnimationActorReplayCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAnimationActorReplayCommandlet::Main(const FString& Params)
+{
+	using namespace AnimActorReplay;
+
+	FString FilePath;
+	int32 Repeat = 1;
+	FString OutputPath = FPaths::ProjectSavedDir() / TEXT("AnimationActorSystem") / TEXT("Replay.json");
+	FParse::Value(*Params, TEXT("File="), FilePath);
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+	Repeat = FMath::Max(Repeat, 1);
+
+	AnimActorSys::FNotifyCapture Capture;
+	if (FilePath.IsEmpty() || !Capture.Load(FilePath))
+	{
+		UE_LOG(LogAnimActorReplay, Error, TEXT("Failed to load the notify capture '%s'."), *FilePath)
+		return 1;
+	}
+
+	FResult Result;
+	Replay(Capture, Repeat, Result);
+	const int32 NumNotifyEvents = Result.NotifyBegin.Microseconds.Num() + Result.NotifyTick.Microseconds.Num() + Result.NotifyEnd.Microseconds.Num();
+
+	FString Json;
+	const TSharedRef<FJsonWriter> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("File"), FilePath);
+	Writer->WriteValue(TEXT("Repeat"), Repeat);
+	Writer->WriteValue(TEXT("Streams"), Capture.GetStreams().Num());
+	Writer->WriteValue(TEXT("Frames"), Result.Frames);
+	Writer->WriteValue(TEXT("NotifyEvents"), NumNotifyEvents);
+	Writer->WriteValue(TEXT("SkippedEvents"), Result.SkippedEvents);
+	Writer->WriteValue(TEXT("CapturedSeconds"), Result.CapturedSeconds);
+	Writer->WriteValue(TEXT("WallSeconds"), Result.WallSeconds);
+	Writer->WriteValue(TEXT("SpeedUp"), Result.WallSeconds > 0.0 ? Result.CapturedSeconds / Result.WallSeconds : 0.0);
+	Writer->WriteValue(TEXT("NotifyEventsPerSecond"), Result.WallSeconds > 0.0 ? NumNotifyEvents / Result.WallSeconds : 0.0);
+	Writer->WriteValue(TEXT("PeakLiveAnimActors"), Result.PeakLiveAnimActors);
+	Writer->WriteObjectStart(TEXT("LatencyMicroseconds"));
+	Result.NotifyBegin.Write(*Writer, TEXT("NotifyBegin"));
+	Result.NotifyTick.Write(*Writer, TEXT("NotifyTick"));
+	Result.NotifyEnd.Write(*Writer, TEXT("NotifyEnd"));
+	Result.WorldTick.Write(*Writer, TEXT("WorldTick"));
+	Writer->WriteObjectEnd();
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(Json, *OutputPath))
+	{
+		UE_LOG(LogAnimActorReplay, Error, TEXT("Failed to write replay results to %s."), *OutputPath)
+		return 1;
+	}
+	UE_LOG(LogAnimActorReplay, Display, TEXT("Replayed %d notify events over %d frames in %.2fs (%.1fx real time). Wrote results to %s."),
+		NumNotifyEvents, Result.Frames, Result.WallSeconds,
+		Result.WallSeconds > 0.0 ? Result.CapturedSeconds / Result.WallSeconds : 0.0, *OutputPath)
+	return 0;
+}
@@ -0,0 +1,61 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#include "AnimationActorBenchmarkUtils.h"
+#include "AnimationActorSubsystem.h"
+#include "AnimNotifyState_SpawnStaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAnimActorSignificanceRoundTripTest, "AnimationActorSystem.Significance.RoundTripKeepsSpawnProfile",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAnimActorSignificanceRoundTripTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = AnimActorBenchmark::CreateWorld(TEXT("AnimActorSignificanceTest"));
+
+	UAnimNotifyState_SpawnStaticMesh* Notify = NewObject<UAnimNotifyState_SpawnStaticMesh>();
+	Notify->SpawnProfile.bDisableShadows = true;
+	Notify->SpawnProfile.bDisablePhysics = true;
+
+	// One actor spawned with the profile and its actor collision turned off, one spawned as configured by its class.
+	AStaticMeshActor* ProfiledActor = World->SpawnActor<AStaticMeshActor>();
+	ProfiledActor->SetActorEnableCollision(false);
+	Notify->ApplySpawnProfile(ProfiledActor);
+	AStaticMeshActor* DefaultActor = World->SpawnActor<AStaticMeshActor>();
+	const bool bDefaultCastShadow = DefaultActor->GetStaticMeshComponent()->CastShadow;
+	const ECollisionEnabled::Type DefaultCollision = DefaultActor->GetStaticMeshComponent()->GetCollisionEnabled();
+
+	AnimActorSys::FSignificanceRestoreState ProfiledState;
+	AnimActorSys::FSignificanceRestoreState DefaultState;
+	for (const EAnimActorSignificance Significance : {EAnimActorSignificance::Reduced, EAnimActorSignificance::Full})
+	{
+		UAnimationActorSubsystem::ApplySignificance(ProfiledActor, nullptr, Significance, ProfiledState);
+		UAnimationActorSubsystem::ApplySignificance(DefaultActor, nullptr, Significance, DefaultState);
+		if (Significance == EAnimActorSignificance::Reduced)
+		{
+			TestFalse(TEXT("Reduced disables shadows"), DefaultActor->GetStaticMeshComponent()->CastShadow);
+			TestFalse(TEXT("Reduced disables collision"), DefaultActor->GetActorEnableCollision());
+		}
+	}
+
+	const UStaticMeshComponent* ProfiledComp = ProfiledActor->GetStaticMeshComponent();
+	TestFalse(TEXT("Full keeps the shadows disabled by the profile"), ProfiledComp->CastShadow);
+	TestEqual(TEXT("Full keeps the collision disabled by the profile"), ProfiledComp->GetCollisionEnabled(), ECollisionEnabled::NoCollision);
+	TestFalse(TEXT("Full keeps the actor collision it was spawned with"), ProfiledActor->GetActorEnableCollision());
+	TestFalse(TEXT("Full shows the actor"), ProfiledActor->IsHidden());
+
+	const UStaticMeshComponent* DefaultComp = DefaultActor->GetStaticMeshComponent();
+	TestEqual(TEXT("Full restores the shadows"), DefaultComp->CastShadow, bDefaultCastShadow);
+	TestEqual(TEXT("Full restores the collision"), DefaultComp->GetCollisionEnabled(), DefaultCollision);
+	TestTrue(TEXT("Full restores the actor collision"), DefaultActor->GetActorEnableCollision());
+
+	AnimActorBenchmark::DestroyWorld(World);
+	return true;
+}
+
+#endif
@@ -0,0 +1,38 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AnimationActorBenchmarkCommandlet.generated.h"
+
+/**
+ * Benchmarks the spawn notifies headlessly and writes the results as JSON, to catch performance regressions.
+ * Drives NotifyBegin/NotifyTick/NotifyEnd on a number of skeletal mesh components in a game world, ticking it in between.
+ *
+ * UnrealEditor-Cmd <Project> -run=AnimationActorBenchmark -nullrhi -unattended [Options]
+ * Notifies that can't be set up are skipped with an error and make the commandlet fail, after writing the remaining results.
+ *
+ * -Notifies=StaticMesh,SkeletalMesh,ActorOfClass	Notifies to benchmark, one after another. SkeletalMesh only by default if -SkeletalMesh is given.
+ * -Components=100		Skeletal mesh components firing the notifies.
+ * -Frames=600			Frames to run per notify.
+ * -Interval=30			Frames between two NotifyBegins on the same component.
+ * -Duration=20			Frames a notify stays active. Overlaps on the same component if larger than Interval.
+ * -Stagger=1			Frames between the first NotifyBegin of consecutive components. 0 begins all at once.
+ * -StaticMeshSpawnMode=Actor	Actor, Instanced or Component.
+ * -StaticMesh=/Engine/BasicShapes/Cube.Cube
+ * -SkeletalMesh=		Mesh for SpawnSkeletalMesh, spawned without animation. Required to benchmark it.
+ * -ActorClass=/Script/Engine.StaticMeshActor
+ * -Output=<Saved>/AnimationActorSystem/Benchmark.json
+ */
+UCLASS()
+class UAnimationActorBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAnimationActorBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
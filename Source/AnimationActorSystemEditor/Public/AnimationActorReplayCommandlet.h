@@ -0,0 +1,30 @@
+// Copyright 2025 Aaron Kemner, All Rights reserved.
+
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AnimationActorReplayCommandlet.generated.h"
+
+/**
+ * Replays a notify capture headlessly, as fast as possible, and writes the timings as JSON.
+ * Captures are recorded in a running game via AnimActorSys.Capture.Start/Stop, see UAnimationActorSubsystem::StartNotifyCapture().
+ * Every component of the capture is stood in for by an empty skeletal mesh component, and the world is ticked with the recorded frame times.
+ *
+ * UnrealEditor-Cmd <Project> -run=AnimationActorReplay -nullrhi -unattended -File=<Capture> [Options]
+ *
+ * -File=				The .aacap file to replay.
+ * -Repeat=1			How often to replay the capture in a row.
+ * -Output=<Saved>/AnimationActorSystem/Replay.json
+ */
+UCLASS()
+class UAnimationActorReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAnimationActorReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};